@@ -272,8 +272,12 @@ Website: http://www.fluxbox.org/\n\n\
 -list-commands\t\t\tlist all valid key commands.\n\
 -sync\t\t\t\tsynchronize with X server for debugging.\n\
 -log <filename>\t\t\tlog output to file.\n\
+-startup-profile\t\ttime the startup phases.\n\
+-startup-trace <filename>\talso write them as a Chrome trace.\n\
 -help\t\t\t\tdisplay this help text and exit.\n\n
 14 warning: couldn't set environment variable 'DISPLAY'
+15 Failed to write the startup trace to
+16 error: '-startup-trace' needs an argument
 
 $set 20 #layers
 
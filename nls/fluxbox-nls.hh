@@ -242,6 +242,8 @@ enum {
 	mainLoggingTo = 10,
 	mainRCRequiresArg = 11,
 	mainScreenRequiresArg = 12,
+	mainStartupTraceFailed = 15,
+	mainStartupTraceRequiresArg = 16,
 	mainUsage = 13,
 	mainWarnDisplayEnv = 14,
 
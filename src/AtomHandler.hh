@@ -41,6 +41,7 @@ public:
 
     virtual void updateFocusedWindow(BScreen &screen, Window win) = 0;
     virtual void updateClientList(BScreen &screen) = 0;
+    virtual void updateClientStacking(BScreen &screen) { }
     virtual void updateWorkspaceNames(BScreen &screen) = 0;
     virtual void updateCurrentWorkspace(BScreen &screen) = 0;
     virtual void updateWorkspaceCount(BScreen &screen) = 0;
@@ -0,0 +1,92 @@
+// BindingIndex.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef BINDINGINDEX_HH
+#define BINDINGINDEX_HH
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Looks up the bindings of one key mode by event type, key and modifiers.
+ *
+ * Ref points to a binding with the members type, mod, key, context and
+ * isdouble. Bindings sharing type, key and modifiers end up in one
+ * bucket, in the order they were added, and each bucket knows the union
+ * of its contexts, so most misses don't even look at a binding.
+ */
+template <typename Ref>
+class BindingIndex {
+public:
+    /// replaces the index with the bindings in [first, last)
+    template <typename Iterator>
+    void build(Iterator first, Iterator last) {
+        m_buckets.clear();
+        for (; first != last; ++first) {
+            if (!*first)
+                continue;
+            Bucket &bucket = m_buckets[hash((*first)->type, (*first)->mod, (*first)->key)];
+            bucket.contexts |= (*first)->context;
+            bucket.bindings.push_back(*first);
+        }
+    }
+
+    /**
+     * @param mod modifiers already stripped to the real modifier mask
+     * @return the first binding that matches, or an empty Ref
+     */
+    Ref find(int type, unsigned int mod, unsigned int key,
+             int context, bool isdouble) const {
+
+        typename Buckets::const_iterator it = m_buckets.find(hash(type, mod, key));
+        if (it == m_buckets.end() || (it->second.contexts & context) == 0)
+            return Ref();
+
+        const std::vector<Ref> &bindings = it->second.bindings;
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            const Ref &b = bindings[i];
+            // the hash is exact, but cheap enough to double check
+            if (b->type == type && b->key == key && b->mod == mod &&
+                (b->context & context) > 0 && b->isdouble == isdouble)
+                return b;
+        }
+        return Ref();
+    }
+
+private:
+    // type is an X event type (< 64), the modifier mask has 8 bits
+    static unsigned long long hash(int type, unsigned int mod, unsigned int key) {
+        return (static_cast<unsigned long long>(type & 0xff) << 40) |
+               (static_cast<unsigned long long>(mod & 0xff) << 32) | key;
+    }
+
+    struct Bucket {
+        Bucket(): contexts(0) { }
+        int contexts;
+        std::vector<Ref> bindings;
+    };
+    typedef std::unordered_map<unsigned long long, Bucket> Buckets;
+
+    Buckets m_buckets;
+};
+
+#endif // BINDINGINDEX_HH
@@ -69,6 +69,7 @@ bool ButtonTheme::fallback(FbTk::ThemeItem_base &item) {
     } else if (item.name().find(".pressed") != std::string::npos) {
         // copy texture
         *m_pressed_texture = texture();
+        FbTk::ThemeManager::instance().loadedFrom(textureTheme());
         // invert the bevel if it has one!
         unsigned long type = m_pressed_texture->type();
         unsigned long bevels = (FbTk::Texture::SUNKEN | FbTk::Texture::RAISED);
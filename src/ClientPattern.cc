@@ -128,6 +128,111 @@ Prop2String property_2_strings[] = { // sorted by 'prop'
 };
 
 
+bool isBoolProperty(ClientPattern::WinProperty prop) {
+    switch (prop) {
+    case ClientPattern::TRANSIENT:
+    case ClientPattern::MAXIMIZED:
+    case ClientPattern::MINIMIZED:
+    case ClientPattern::FULLSCREEN:
+    case ClientPattern::VERTMAX:
+    case ClientPattern::HORZMAX:
+    case ClientPattern::SHADED:
+    case ClientPattern::STUCK:
+    case ClientPattern::FOCUSHIDDEN:
+    case ClientPattern::ICONHIDDEN:
+    case ClientPattern::URGENT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool boolProperty(ClientPattern::WinProperty prop, const Focusable &client) {
+
+    const FluxboxWindow *fbwin = client.fbwindow();
+
+    switch (prop) {
+    case ClientPattern::TRANSIENT:
+        return client.isTransient();
+    case ClientPattern::MAXIMIZED:
+        return fbwin && fbwin->isMaximized();
+    case ClientPattern::MINIMIZED:
+        return fbwin && fbwin->isIconic();
+    case ClientPattern::FULLSCREEN:
+        return fbwin && fbwin->isFullscreen();
+    case ClientPattern::VERTMAX:
+        return fbwin && fbwin->isMaximizedVert();
+    case ClientPattern::HORZMAX:
+        return fbwin && fbwin->isMaximizedHorz();
+    case ClientPattern::SHADED:
+        return fbwin && fbwin->isShaded();
+    case ClientPattern::STUCK:
+        return fbwin && fbwin->isStuck();
+    case ClientPattern::FOCUSHIDDEN:
+        return fbwin && fbwin->isFocusHidden();
+    case ClientPattern::ICONHIDDEN:
+        return fbwin && fbwin->isIconHidden();
+    case ClientPattern::URGENT:
+        return Fluxbox::instance()->attentionHandler().isDemandingAttention(client);
+    default:
+        return false;
+    }
+}
+
+bool isNumberProperty(ClientPattern::WinProperty prop) {
+    return prop == ClientPattern::WORKSPACE || prop == ClientPattern::HEAD ||
+           prop == ClientPattern::SCREEN;
+}
+
+// @return false if the client has no value for the property
+bool numberProperty(ClientPattern::WinProperty prop, const Focusable &client, long &value) {
+
+    const FluxboxWindow *fbwin = client.fbwindow();
+
+    switch (prop) {
+    case ClientPattern::WORKSPACE:
+        value = fbwin ? fbwin->workspaceNumber() : client.screen().currentWorkspaceID();
+        return true;
+    case ClientPattern::HEAD:
+        if (!fbwin)
+            return false;
+        value = client.screen().getHead(fbwin->fbWindow());
+        return true;
+    case ClientPattern::SCREEN:
+        value = client.screen().screenNumber();
+        return true;
+    default:
+        return false;
+    }
+}
+
+// the properties the client keeps as a string anyway, 0 for the others
+const FbTk::FbString *storedProperty(ClientPattern::WinProperty prop, const Focusable &client) {
+    switch (prop) {
+    case ClientPattern::TITLE:
+        return &client.title().logical();
+    case ClientPattern::CLASS:
+        return &client.getWMClassClass();
+    case ClientPattern::NAME:
+        return &client.getWMClassName();
+    default:
+        return 0;
+    }
+}
+
+// the way number2String() writes a number, nothing else
+bool parseNumber(const FbTk::FbString &str, long &value) {
+    if (str.empty() || str.size() > 9 || (str[0] == '0' && str.size() > 1))
+        return false;
+    value = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] < '0' || str[i] > '9')
+            return false;
+        value = value * 10 + (str[i] - '0');
+    }
+    return true;
+}
+
 } // end of anonymous namespace
 
 
@@ -136,19 +241,54 @@ Prop2String property_2_strings[] = { // sorted by 'prop'
  * We have a "term" in the whole expression which is the full pattern
  * we also need to keep track of the uncompiled regular expression
  * for final output
+ *
+ * When the term is created, it is compiled to the cheapest way to
+ * match it: literal values are compared directly to the property,
+ * as a number, a boolean or a string, without building its text.
  */
 struct ClientPattern::Term {
 
+    enum Kind {
+        MATCH_REGEXP,  ///< the regexp against the text of the property
+        MATCH_STRING,  ///< string compare against 'literal'
+        MATCH_NUMBER,  ///< integer compare against 'number'
+        MATCH_BOOL,    ///< compare against 'number' != 0
+        MATCH_XPROP,   ///< the regexp against an X property
+        MATCH_CURRENT, ///< the same value as the focused window or current workspace
+        MATCH_MOUSE    ///< the head the mouse is on
+    };
+
     Term(const FbTk::FbString& _regstr, WinProperty _prop, bool _negate, const FbTk::FbString& _xprop) :
         regstr(_regstr),
         xpropstr(_xprop),
+        xprop(None),
         regexp(_regstr, true),
         prop(_prop),
-        negate(_negate) {
-
-        xprop = XInternAtom(FbTk::App::instance()->display(), xpropstr.c_str(), False);
+        negate(_negate),
+        kind(MATCH_REGEXP),
+        number(0) {
+
+        if (prop == XPROP) {
+            xprop = XInternAtom(FbTk::App::instance()->display(), xpropstr.c_str(), False);
+            kind = MATCH_XPROP;
+        } else if (regstr == "[current]")
+            kind = MATCH_CURRENT;
+        else if (prop == HEAD && regstr == "[mouse]")
+            kind = MATCH_MOUSE;
+        else if (regexp.literal(literal)) {
+            if (isBoolProperty(prop) && (literal == "yes" || literal == "no")) {
+                kind = MATCH_BOOL;
+                number = literal == "yes";
+            } else if (isNumberProperty(prop) && parseNumber(literal, number))
+                kind = MATCH_NUMBER;
+            else if (!isBoolProperty(prop) && !isNumberProperty(prop))
+                kind = MATCH_STRING;
+        }
     }
 
+    /// does the client's property match, disregarding 'negate'
+    bool matches(const Focusable &win) const;
+
     // (title=.*bar) or (@FOO=.*bar)
     FbTk::FbString regstr;     // .*bar
     FbTk::FbString xpropstr;  // @FOO=.*bar
@@ -156,8 +296,38 @@ struct ClientPattern::Term {
     FbTk::RegExp regexp;       // compiled version of '.*bar'
     WinProperty prop;
     bool negate;
+
+    Kind kind;
+    FbTk::FbString literal;    // 'bar' for (title=bar)
+    long number;               // 3 for (workspace=3), 1 for (shaded=yes)
 };
 
+bool ClientPattern::Term::matches(const Focusable &win) const {
+    long value;
+
+    switch (kind) {
+    case MATCH_STRING: {
+        const FbTk::FbString *stored = storedProperty(prop, win);
+        return stored ? *stored == literal : getProperty(prop, win) == literal;
+    }
+    case MATCH_NUMBER:
+        return numberProperty(prop, win, value) && value == number;
+    case MATCH_BOOL:
+        return boolProperty(prop, win) == (number != 0);
+    case MATCH_XPROP:
+        return regexp.match(win.getTextProperty(xprop)) ||
+               regexp.match(FbTk::StringUtil::number2String(win.getCardinalProperty(xprop)));
+    case MATCH_MOUSE:
+        return numberProperty(prop, win, value) && value == win.screen().getCurrHead();
+    case MATCH_CURRENT: // handled in ClientPattern::match()
+    case MATCH_REGEXP:
+        break;
+    }
+
+    const FbTk::FbString *stored = storedProperty(prop, win);
+    return stored ? regexp.match(*stored) : regexp.match(getProperty(prop, win));
+}
+
 ClientPattern::ClientPattern():
     m_matchlimit(0),
     m_nummatches(0) {}
@@ -314,13 +484,12 @@ bool ClientPattern::match(const Focusable &win) const {
     Terms::const_iterator it_end = m_terms.end();
     for (; it != it_end; ++it) {
         const Term& term = *(*it);
-        if (term.prop == XPROP) {
-            if (!term.negate ^ ((term.regexp.match(win.getTextProperty(term.xprop))) || term.regexp.match(FbTk::StringUtil::number2String(win.getCardinalProperty(term.xprop)))))
-                return false;
-        } else if (term.regstr == "[current]") {
+        if (term.kind == Term::MATCH_CURRENT) {
             WinClient *focused = FocusControl::focusedWindow();
             if (term.prop == WORKSPACE) {
-                if (!term.negate ^ (getProperty(term.prop, win) == FbTk::StringUtil::number2String(win.screen().currentWorkspaceID())))
+                long ws;
+                numberProperty(term.prop, win, ws);
+                if (!term.negate ^ (ws == static_cast<long>(win.screen().currentWorkspaceID())))
                     return false;
             } else if (term.prop == WORKSPACENAME) {
                 const Workspace *w = win.screen().currentWorkspace();
@@ -328,11 +497,7 @@ bool ClientPattern::match(const Focusable &win) const {
                     return false;
             } else if (!focused || (!term.negate ^ (getProperty(term.prop, win) == getProperty(term.prop, *focused))))
                 return false;
-        } else if (term.prop == HEAD && term.regstr == "[mouse]") {
-            if (!term.negate ^ (getProperty(term.prop, win) == FbTk::StringUtil::number2String(win.screen().getCurrHead())))
-                return false;
-
-        } else if (!term.negate ^ term.regexp.match(getProperty(term.prop, win)))
+        } else if (!term.negate ^ term.matches(win))
             return false;
     }
     return true;
@@ -358,6 +523,20 @@ bool ClientPattern::dependsOnCurrentWorkspace() const {
     return false;
 }
 
+bool ClientPattern::literalTerm(WinProperty &prop, FbTk::FbString &value) const {
+    Terms::const_iterator it = m_terms.begin(), it_end = m_terms.end();
+    for (; it != it_end; ++it) {
+        const Term &term = *(*it);
+        if ((term.prop == NAME || term.prop == CLASS || term.prop == ROLE) &&
+            !term.negate && term.regstr != "[current]" &&
+            term.regexp.literal(value)) {
+            prop = term.prop;
+            return true;
+        }
+    }
+    return false;
+}
+
 // add an expression to match against
 // The first argument is a regular expression, the second is the member
 // function that we wish to match against.
@@ -396,38 +575,24 @@ FbTk::FbString ClientPattern::getProperty(WinProperty prop, const Focusable &cli
         result = client.getWMRole();
         break;
     case TRANSIENT:
-        result = client.isTransient() ? "yes" : "no";
-        break;
     case MAXIMIZED:
-        result = (fbwin && fbwin->isMaximized()) ? "yes" : "no";
-        break;
     case MINIMIZED:
-        result = (fbwin && fbwin->isIconic()) ? "yes" : "no";
-        break;
     case FULLSCREEN:
-        result = (fbwin && fbwin->isFullscreen()) ? "yes" : "no";
-        break;
     case VERTMAX:
-        result = (fbwin && fbwin->isMaximizedVert()) ? "yes" : "no";
-        break;
     case HORZMAX:
-        result = (fbwin && fbwin->isMaximizedHorz()) ? "yes" : "no";
-        break;
     case SHADED:
-        result = (fbwin && fbwin->isShaded()) ? "yes" : "no";
-        break;
     case STUCK:
-        result = (fbwin && fbwin->isStuck()) ? "yes" : "no";
-        break;
     case FOCUSHIDDEN:
-        result = (fbwin && fbwin->isFocusHidden()) ? "yes" : "no";
-        break;
     case ICONHIDDEN:
-        result = (fbwin && fbwin->isIconHidden()) ? "yes" : "no";
+    case URGENT:
+        result = boolProperty(prop, client) ? "yes" : "no";
         break;
-    case WORKSPACE: {
-        unsigned int wsnum = (fbwin ? fbwin->workspaceNumber() : client.screen().currentWorkspaceID());
-        result = FbTk::StringUtil::number2String(wsnum);
+    case WORKSPACE:
+    case HEAD:
+    case SCREEN: {
+        long number;
+        if (numberProperty(prop, client, number))
+            result = FbTk::StringUtil::number2String(number);
         break;
     }
     case WORKSPACENAME: {
@@ -439,24 +604,11 @@ FbTk::FbString ClientPattern::getProperty(WinProperty prop, const Focusable &cli
         }
         break;
     }
-    case HEAD:
-        if (fbwin) {
-            result = FbTk::StringUtil::number2String(client.screen().getHead(fbwin->fbWindow()));
-        }
-        break;
     case LAYER:
         if (fbwin) {
             result = ::ResourceLayer::getString(fbwin->layerNum());
         }
         break;
-    case URGENT:
-        result = Fluxbox::instance()->attentionHandler()
-                .isDemandingAttention(client) ? "yes" : "no";
-        break;
-    case SCREEN:
-        result = FbTk::StringUtil::number2String(client.screen().screenNumber());
-        break;
-
     case XPROP:
         break;
 
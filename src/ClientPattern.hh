@@ -67,6 +67,13 @@ public:
     /// Does this pattern depend on the current workspace?
     bool dependsOnCurrentWorkspace() const;
 
+    /**
+     * Finds a term that only matches one exact name, class or role.
+     * Clients without that value can't match the whole pattern.
+     * @return false if there is no such term
+     */
+    bool literalTerm(WinProperty &prop, FbTk::FbString &value) const;
+
     /**
      * Add an expression to match against
      * @param str is a regular expression
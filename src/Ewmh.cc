@@ -34,8 +34,10 @@
 #include "FbTk/App.hh"
 #include "FbTk/FbWindow.hh"
 #include "FbTk/I18n.hh"
+#include "FbTk/MemFun.hh"
 #include "FbTk/LayerItem.hh"
 #include "FbTk/Layer.hh"
+#include "FbTk/MultLayers.hh"
 #include "FbTk/FbPixmap.hh"
 
 #include <X11/Xproto.h>
@@ -611,6 +613,8 @@ void Ewmh::initForScreen(BScreen &screen) {
     updateWorkspaceCount(screen);
     updateCurrentWorkspace(screen);
     updateWorkspaceNames(screen);
+    m_tracker.join(screen.layerManager().stackingSig(),
+                   FbTk::MemFun(*this, &Ewmh::itemRestacked));
     updateClientList(screen);
     updateViewPort(screen);
     updateGeometry(screen);
@@ -619,6 +623,7 @@ void Ewmh::initForScreen(BScreen &screen) {
 }
 
 void Ewmh::setupClient(WinClient &winclient) {
+    m_client_lists[winclient.screen().screenNumber()].clients.push_back(winclient.window());
     updateStrut(winclient);
 
     FbTk::FbString newtitle = winclient.textProperty(m_net->wm_name);
@@ -633,6 +638,23 @@ void Ewmh::setupClient(WinClient &winclient) {
 
     extractNetWmIcon(m_net->wm_icon, winclient);
 
+    // the only state that is kept from what the client set before mapping,
+    // updateState() takes care of the rest
+    ClientState &shadow = m_client_states[winclient.window()];
+    shadow = ClientState();
+    winclient.property(m_net->wm_state, 0, 0x7fffffff, False, XA_ATOM,
+                       &ret_type, &fmt, &nitems, &bytes_after,
+                       &data);
+    if (data) {
+        Atom *states = (Atom *)data;
+        for (unsigned long i = 0; i < nitems; ++i) {
+            if (states[i] == m_net->wm_state_skip_pager)
+                shadow.skip_pager = true;
+        }
+        XFree(data);
+        data = 0;
+    }
+
 
     /* From Extended Window Manager Hints, draft 1.3:
      *
@@ -708,9 +730,19 @@ void Ewmh::setupFrame(FluxboxWindow &win) {
 
     updateFrameExtents(win);
 
+    ClientLists &lists = m_client_lists[win.screen().screenNumber()];
+    FrameList::iterator frame = lists.frames.insert(lists.frames.end(), &win);
+    m_frames[&win.layerItem()] = frame;
+    placeFrame(win, frame);
 }
 
 void Ewmh::updateFrameClose(FluxboxWindow &win) {
+    std::map<const FbTk::LayerItem *, FrameList::iterator>::iterator
+        frame = m_frames.find(&win.layerItem());
+    if (frame == m_frames.end())
+        return;
+    m_client_lists[win.screen().screenNumber()].frames.erase(frame->second);
+    m_frames.erase(frame);
 }
 
 void Ewmh::updateFocusedWindow(BScreen &screen, Window win) {
@@ -733,6 +765,9 @@ void Ewmh::updateFocusedWindow(BScreen &screen, Window win) {
 // The Window Manager should remove the property whenever a window is withdrawn
 // but it should leave the property in place when it is shutting down
 void Ewmh::updateClientClose(WinClient &winclient){
+    m_client_states.erase(winclient.window());
+    vector<Window> &clients = m_client_lists[winclient.screen().screenNumber()].clients;
+    clients.erase(std::remove(clients.begin(), clients.end(), winclient.window()), clients.end());
     if (!winclient.screen().isShuttingdown()) {
         XDeleteProperty(FbTk::App::instance()->display(), winclient.window(),
                         m_net->wm_state);
@@ -746,27 +781,6 @@ void Ewmh::updateClientList(BScreen &screen) {
     if (screen.isShuttingdown())
         return;
 
-    list<Focusable *> creation_order_list =
-            screen.focusControl().creationOrderList().clientList();
-
-    size_t num = creation_order_list.size();
-    Window *wl = FB_new_nothrow Window[num];
-    if (wl == 0) {
-        _FB_USES_NLS;
-        cerr<<_FB_CONSOLETEXT(Ewmh, OutOfMemoryClientList,
-                      "Fatal: Out of memory, can't allocate for EWMH client list", "")<<endl;
-        return;
-    }
-
-    int win=0;
-    list<Focusable *>::iterator client_it = creation_order_list.begin();
-    list<Focusable *>::iterator client_it_end = creation_order_list.end();
-    for (; client_it != client_it_end; ++client_it) {
-        WinClient *client = dynamic_cast<WinClient *>(*client_it);
-        if (client)
-            wl[win++] = client->window();
-    }
-
     /*  From Extended Window Manager Hints, draft 1.3:
      *
      * _NET_CLIENT_LIST, WINDOW[]/32
@@ -780,14 +794,121 @@ void Ewmh::updateClientList(BScreen &screen) {
      * SHOULD be set and updated by the Window
      * Manager.
      */
-    screen.rootWindow().changeProperty(m_net->client_list,
-                                       XA_WINDOW, 32,
-                                       PropModeReplace, (unsigned char *)wl, num);
-    screen.rootWindow().changeProperty(m_net->client_list_stacking,
-                                       XA_WINDOW, 32,
-                                       PropModeReplace, (unsigned char *)wl, num);
+    ClientLists &lists = m_client_lists[screen.screenNumber()];
+    writeWindowList(screen, m_net->client_list, lists.mapping, lists.clients);
 
-    delete [] wl;
+    updateClientStacking(screen);
+}
+
+void Ewmh::updateClientStacking(BScreen &screen) {
+
+    if (screen.isShuttingdown())
+        return;
+
+    ClientLists &lists = m_client_lists[screen.screenNumber()];
+    if (lists.restacked) {
+        // layer 0 is the top one and every layer lists its items top first
+        FbTk::MultLayers &layers = screen.layerManager();
+        for (int layer = layers.size() - 1; layer >= 0; --layer) {
+            const FbTk::Layer::ItemList &items = layers.getLayer(layer)->itemList();
+            FbTk::Layer::ItemList::const_reverse_iterator it = items.rbegin();
+            FbTk::Layer::ItemList::const_reverse_iterator it_end = items.rend();
+            for (; it != it_end; ++it) {
+                std::map<const FbTk::LayerItem *, FrameList::iterator>::const_iterator
+                    frame = m_frames.find(*it);
+                if (frame != m_frames.end())
+                    lists.frames.splice(lists.frames.end(), lists.frames, frame->second);
+            }
+        }
+        lists.restacked = false;
+    }
+
+    m_scratch_list.clear();
+    FrameList::const_iterator frame = lists.frames.begin();
+    FrameList::const_iterator frame_end = lists.frames.end();
+    for (; frame != frame_end; ++frame) {
+        // the visible client of a tab group is on top of the others
+        const FluxboxWindow::ClientList &clients = (*frame)->clientList();
+        const WinClient *current = &(*frame)->winClient();
+        FluxboxWindow::ClientList::const_iterator client = clients.begin();
+        for (; client != clients.end(); ++client) {
+            if (*client != current)
+                m_scratch_list.push_back((*client)->window());
+        }
+        m_scratch_list.push_back(current->window());
+    }
+
+    writeWindowList(screen, m_net->client_list_stacking, lists.stacking, m_scratch_list);
+}
+
+void Ewmh::itemRestacked(FbTk::LayerItem *item) {
+    if (item == 0) {
+        std::map<int, ClientLists>::iterator it = m_client_lists.begin();
+        for (; it != m_client_lists.end(); ++it)
+            it->second.restacked = true;
+        return;
+    }
+
+    std::map<const FbTk::LayerItem *, FrameList::iterator>::iterator
+        frame = m_frames.find(item);
+    if (frame != m_frames.end())
+        placeFrame(**frame->second, frame->second);
+}
+
+void Ewmh::placeFrame(FluxboxWindow &win, FrameList::iterator frame) {
+    ClientLists &lists = m_client_lists[win.screen().screenNumber()];
+    if (lists.restacked)
+        return;
+
+    FbTk::MultLayers &layers = win.screen().layerManager();
+    FbTk::LayerItem &item = win.layerItem();
+    const int own_layer = item.getLayer().getLayerNum();
+
+    // the layers list their items top first, so the frame below is the
+    // next one in the layer of the item or in the layers under it
+    FrameList::iterator below = lists.frames.end();
+    for (int layer = own_layer; below == lists.frames.end() && layer < layers.size(); ++layer) {
+        const FbTk::Layer::ItemList &items = layers.getLayer(layer)->itemList();
+        FbTk::Layer::ItemList::const_iterator it = items.begin();
+        if (layer == own_layer) {
+            it = std::find(items.begin(), items.end(), &item);
+            // on the way to another layer, which tells where it went
+            if (it == items.end())
+                return;
+            ++it;
+        }
+        for (; below == lists.frames.end() && it != items.end(); ++it) {
+            std::map<const FbTk::LayerItem *, FrameList::iterator>::const_iterator
+                other = m_frames.find(*it);
+            if (other != m_frames.end())
+                below = other->second;
+        }
+    }
+
+    if (below == lists.frames.end())
+        lists.frames.splice(lists.frames.begin(), lists.frames, frame);
+    else
+        lists.frames.splice(++below, lists.frames, frame);
+}
+
+void Ewmh::writeWindowList(BScreen &screen, Atom atom,
+                           vector<Window> &old, const vector<Window> &list) {
+
+    if (list == old)
+        return;
+
+    // new windows usually just end up at the end of the list, then only
+    // they have to be sent
+    if (!old.empty() && old.size() < list.size() &&
+        std::equal(old.begin(), old.end(), list.begin())) {
+        screen.rootWindow().changeProperty(atom, XA_WINDOW, 32, PropModeAppend,
+                (unsigned char *)&list[old.size()], list.size() - old.size());
+    } else {
+        screen.rootWindow().changeProperty(atom, XA_WINDOW, 32, PropModeReplace,
+                (unsigned char *)(list.empty() ? 0 : &list[0]), list.size());
+    }
+
+    old = list;
 }
 
 void Ewmh::updateWorkspaceNames(BScreen &screen) {
@@ -988,36 +1109,26 @@ void Ewmh::updateState(FluxboxWindow &win) {
     if (win.isFullscreen())
         state.push_back(m_net->wm_state_fullscreen);
 
+    // the state of the frame is the same for all clients, so it only
+    // is worked out once; none of this needs to ask the server
     FluxboxWindow::ClientList::iterator it = win.clientList().begin();
     FluxboxWindow::ClientList::iterator it_end = win.clientList().end();
     for (; it != it_end; ++it) {
 
         StateVec client_state(state);
-        Atom ret_type;
-        int fmt;
-        unsigned long nitems, bytes_after;
-        unsigned char *data = 0;
+        ClientState &shadow = m_client_states[(*it)->window()];
 
         // set client-specific state
         if ((*it)->isStateModal())
             client_state.push_back(m_net->wm_state_modal);
         if (Fluxbox::instance()->attentionHandler().isDemandingAttention(**it))
             client_state.push_back(m_net->wm_state_demands_attention);
+        // we don't act on _NET_WM_STATE_SKIP_PAGER, but mustn't drop it
+        if (shadow.skip_pager)
+            client_state.push_back(m_net->wm_state_skip_pager);
 
-        // search the old states for _NET_WM_STATE_SKIP_PAGER and append it
-        // to the current state, so it wont get deleted by us.
-        (*it)->property(m_net->wm_state, 0, 0x7fffffff, False, XA_ATOM,
-                                 &ret_type, &fmt, &nitems, &bytes_after,
-                                 &data);
-        if (data) {
-            Atom *old_states = (Atom *)data;
-            for (unsigned long i=0; i < nitems; ++i) {
-                if (old_states[i] == m_net->wm_state_skip_pager) {
-                    client_state.push_back(m_net->wm_state_skip_pager);
-                }
-            }
-            XFree(data);
-        }
+        if (shadow.written && shadow.state == client_state)
+            continue;
 
         if (!client_state.empty()) {
             (*it)->changeProperty(m_net->wm_state, XA_ATOM, 32, PropModeReplace,
@@ -1025,6 +1136,9 @@ void Ewmh::updateState(FluxboxWindow &win) {
                                   client_state.size());
         } else
             (*it)->deleteProperty(m_net->wm_state);
+
+        shadow.state.swap(client_state);
+        shadow.written = true;
     }
 }
 
@@ -1044,8 +1158,14 @@ void Ewmh::updateWorkspace(FluxboxWindow &win) {
     FluxboxWindow::ClientList::iterator it = win.clientList().begin();
     FluxboxWindow::ClientList::iterator it_end = win.clientList().end();
     for (; it != it_end; ++it) {
+        // stuck windows are moved along on every workspace switch
+        ClientState &shadow = m_client_states[(*it)->window()];
+        if (shadow.desktop_written && shadow.desktop == workspace)
+            continue;
         (*it)->changeProperty(m_net->wm_desktop, XA_CARDINAL, 32, PropModeReplace,
                               (unsigned char *)&workspace, 1);
+        shadow.desktop = workspace;
+        shadow.desktop_written = true;
     }
 
 }
@@ -1100,6 +1220,8 @@ bool Ewmh::checkClientMessage(const XClientMessageEvent &ce,
             toggleState(win, ce.data.l[1]);
             toggleState(win, ce.data.l[2]);
         }
+        // in case only states the window doesn't know about changed
+        updateState(win);
         return true;
     } else if (ce.message_type == m_net->number_of_desktops) {
         if (screen == 0)
@@ -1347,6 +1469,8 @@ void Ewmh::setState(FluxboxWindow &win, Atom state, bool value,
         }
     } else if (state == m_net->wm_state_modal) {
         client.setStateModal(value);
+    } else if (state == m_net->wm_state_skip_pager) {
+        m_client_states[client.window()].skip_pager = value;
     }
 
 }
@@ -1383,6 +1507,9 @@ void Ewmh::toggleState(FluxboxWindow &win, Atom state, WinClient &client) {
             win.moveToLayer(ResourceLayer::ABOVE_DOCK);
     } else if (state == m_net->wm_state_modal) { // modal
         client.setStateModal(!client.isStateModal());
+    } else if (state == m_net->wm_state_skip_pager) {
+        bool &skip_pager = m_client_states[client.window()].skip_pager;
+        skip_pager = !skip_pager;
     }
 
 }
@@ -1466,9 +1593,13 @@ void Ewmh::updateActions(FluxboxWindow &win) {
     FluxboxWindow::ClientList::iterator it = win.clientList().begin();
     FluxboxWindow::ClientList::iterator it_end = win.clientList().end();
     for (; it != it_end; ++it) {
+        ActionsVector &written = m_client_states[(*it)->window()].actions;
+        if (written == actions)
+            continue;
         (*it)->changeProperty(m_net->wm_allowed_actions, XA_ATOM, 32, PropModeReplace,
                               reinterpret_cast<unsigned char*>(&actions.front()),
                               actions.size());
+        written = actions;
     }
 
 }
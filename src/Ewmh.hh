@@ -21,6 +21,15 @@
 
 #include "AtomHandler.hh"
 #include "FbTk/FbString.hh"
+#include "FbTk/Signal.hh"
+
+#include <list>
+#include <map>
+#include <vector>
+
+namespace FbTk {
+class LayerItem;
+}
 
 /// Implementes Extended Window Manager Hints ( http://www.freedesktop.org/Standards/wm-spec )
 class Ewmh:public AtomHandler {
@@ -35,6 +44,7 @@ public:
 
     void updateFocusedWindow(BScreen &screen, Window win);
     void updateClientList(BScreen &screen);
+    void updateClientStacking(BScreen &screen);
     void updateWorkspaceNames(BScreen &screen);
     void updateCurrentWorkspace(BScreen &screen);
     void updateWorkspaceCount(BScreen &screen);
@@ -72,6 +82,49 @@ private:
 
     FbTk::FbString getUTF8Property(Atom property);
 
+    /// writes 'list' to the root window property 'atom', appending to
+    /// what was written last time ('old') where possible
+    void writeWindowList(BScreen &screen, Atom atom,
+                         std::vector<Window> &old, const std::vector<Window> &list);
+
+    typedef std::list<FluxboxWindow *> FrameList;
+
+    /// moves the frame of the item to its new place, 0 means any of them
+    void itemRestacked(FbTk::LayerItem *item);
+    /// puts the frame right above the nearest frame below it in the layers
+    void placeFrame(FluxboxWindow &win, FrameList::iterator frame);
+
+    /// the clients of a screen for _NET_CLIENT_LIST(_STACKING), kept up to
+    /// date as they map, unmap and restack, and what was last written
+    struct ClientLists {
+        ClientLists(): restacked(false) { }
+        std::vector<Window> clients; ///< in mapping order
+        FrameList frames;            ///< bottom to top
+        bool restacked;              ///< frames has to be read from the layers again
+        std::vector<Window> mapping, stacking;
+    };
+    std::map<int, ClientLists> m_client_lists;
+    /// where each frame is in the frames of its screen
+    std::map<const FbTk::LayerItem *, FrameList::iterator> m_frames;
+    std::vector<Window> m_scratch_list;
+    FbTk::SignalTracker m_tracker;
+
+    /// what was last written to a client's _NET_WM_STATE,
+    /// _NET_WM_ALLOWED_ACTIONS and _NET_WM_DESKTOP, along with the states
+    /// we keep for the client without acting on them
+    struct ClientState {
+        ClientState(): written(false), skip_pager(false),
+                       desktop_written(false), desktop(0) { }
+        bool written;
+        bool skip_pager;
+        std::vector<Atom> state;
+        std::vector<Atom> actions;
+        bool desktop_written;
+        long desktop;
+    };
+    typedef std::map<Window, ClientState> ClientStates;
+    ClientStates m_client_states;
+
     class EwmhAtoms;
     EwmhAtoms* m_net;
 };
@@ -34,6 +34,7 @@
 #include "FbTk/Menu.hh"
 #include "FbTk/CommandParser.hh"
 #include "FbTk/StringUtil.hh"
+#include "FbTk/TextUtils.hh"
 #include "FbTk/stringstream.hh"
 
 #include <sys/types.h>
@@ -604,5 +605,15 @@ void ClientPatternTestCmd::execute() {
     }
 }
 
+REGISTER_COMMAND(textlayoutstats, FbCommands::TextLayoutStatsCmd, void);
+
+void TextLayoutStatsCmd::execute() {
+    const FbTk::TextLayoutStats stats = FbTk::textLayoutStats();
+    const unsigned long lookups = stats.hits + stats.misses;
+    std::cerr<<"TextLayoutStats: "<<lookups<<" lookups, "<<stats.hits<<" hits ("
+             <<(lookups ? stats.hits * 100 / lookups : 0)<<"%), "
+             <<stats.size<<" of "<<stats.capacity<<" layouts kept"<<endl;
+}
+
 
 } // end namespace FbCommands
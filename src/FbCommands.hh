@@ -228,6 +228,12 @@ private:
     std::string m_args;
 };
 
+/// prints how often the text layout cache was hit
+class TextLayoutStatsCmd: public FbTk::Command<void> {
+public:
+    void execute();
+};
+
 } // end namespace FbCommands
 
 #endif // FBCOMMANDS_HH
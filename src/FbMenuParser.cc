@@ -24,14 +24,36 @@
 
 #include "FbTk/StringUtil.hh"
 
+#include <sys/stat.h>
+
 bool FbMenuParser::open(const std::string &filename) {
     m_file.open(filename.c_str());
+    m_filename = filename;
+    struct stat st;
+    if (stat(filename.c_str(), &st) == 0) {
+        m_mtime = st.st_mtime;
+        m_size = st.st_size;
+    } else {
+        m_mtime = 0;
+        m_size = 0;
+    }
     m_curr_pos = 0;
     m_row = 0;
     m_curr_token = DONE;
     return isLoaded();
 }
 
+bool FbMenuParser::seek(std::streampos pos, int row) {
+    m_file.clear();
+    if (pos == std::streampos(-1) || !m_file.seekg(pos))
+        return false;
+    m_curr_line.clear();
+    m_curr_pos = 0;
+    m_row = row;
+    m_curr_token = DONE;
+    return true;
+}
+
 FbTk::Parser &FbMenuParser::operator >> (FbTk::Parser::Item &out) {
     if (eof()) {        
         out = FbTk::Parser::s_empty_item;
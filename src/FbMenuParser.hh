@@ -26,11 +26,15 @@
 #include "FbTk/Parser.hh"
 
 #include <fstream>
+#include <sys/types.h>
+#include <ctime>
 
 class FbMenuParser: public FbTk::Parser {
 public:
-    FbMenuParser():m_row(0), m_curr_pos(0), m_curr_token(TYPE) {}
-    FbMenuParser(const std::string &filename):m_row(0), m_curr_pos(0),
+    FbMenuParser():m_mtime(0), m_size(0), m_row(0), m_curr_pos(0),
+                   m_curr_token(TYPE) {}
+    FbMenuParser(const std::string &filename):m_mtime(0), m_size(0),
+                                              m_row(0), m_curr_pos(0),
                                               m_curr_token(TYPE) { open(filename); }
     ~FbMenuParser() { close(); }
 
@@ -43,10 +47,24 @@ public:
     bool eof() const { return m_file.eof(); }
     int row() const { return m_row; }
     std::string line() const { return m_curr_line; }
+    const std::string &filename() const { return m_filename; }
+    /// modification time of the file when it was opened
+    time_t mtime() const { return m_mtime; }
+    /// size of the file when it was opened
+    off_t size() const { return m_size; }
+
+    /// where the next line starts
+    std::streampos position() const { return m_file.tellg(); }
+    /// continues at a position(), which is on line row + 1
+    bool seek(std::streampos pos, int row);
+
 private:
     bool nextLine();
 
     mutable std::ifstream m_file;
+    std::string m_filename;
+    time_t m_mtime;
+    off_t m_size;
     int m_row;
     int m_curr_pos;
     std::string m_curr_line;
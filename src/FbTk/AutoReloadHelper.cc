@@ -23,12 +23,95 @@
 
 #include "FileUtil.hh"
 #include "StringUtil.hh"
+#include "Timer.hh"
+
+#include <set>
+#include <vector>
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 namespace FbTk {
 
+namespace {
+
+std::set<AutoReloadHelper *> s_helpers;
+
+#ifdef HAVE_SYS_INOTIFY_H
+
+// editors save by writing or by renaming a new file over the old one
+const uint32_t WATCH_MASK = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                            IN_MOVED_FROM | IN_MOVED_TO;
+
+int s_inotify = -2; // -2 until it's needed
+std::map<int, std::string> s_watched_dirs;
+
+// an editor writes a file in a few steps, reload after the last one
+const uint64_t SETTLE_TIME = 300 * FbTime::IN_MILLISECONDS;
+
+// never destroyed, it would outlive the list of running timers
+Timer &settleTimer() {
+    static Timer *timer = new Timer();
+    return *timer;
+}
+
+#endif // HAVE_SYS_INOTIFY_H
+
+// @return false if the file needs polling
+bool watch(const std::string &filename, const RefCount<Slot<void> > &handler) {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (s_inotify == -2) {
+        s_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (s_inotify >= 0)
+            Timer::watchFd(s_inotify, handler);
+    }
+    if (s_inotify < 0)
+        return false;
+
+    std::string dir = filename;
+    if (!FileUtil::isDirectory(filename.c_str())) {
+        std::string::size_type slash = filename.rfind('/');
+        if (slash == std::string::npos)
+            return false;
+        dir = slash == 0 ? "/" : filename.substr(0, slash);
+    }
+
+    int wd = inotify_add_watch(s_inotify, dir.c_str(), WATCH_MASK);
+    if (wd < 0)
+        return false;
+    s_watched_dirs[wd] = dir;
+    return true;
+#else
+    return false;
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+} // end anonymous namespace
+
+AutoReloadHelper::AutoReloadHelper():
+    m_poll(false),
+    m_changed(false) {
+    s_helpers.insert(this);
+}
+
+AutoReloadHelper::~AutoReloadHelper() {
+    s_helpers.erase(this);
+}
+
 void AutoReloadHelper::checkReload() {
     if (!m_reload_cmd.get())
         return;
+
+    if (!m_poll) {
+        // changes that didn't settle yet
+        readEvents(std::string());
+        if (m_changed)
+            reload();
+        return;
+    }
+
     TimestampMap::const_iterator it = m_timestamps.begin();
     TimestampMap::const_iterator it_end = m_timestamps.end();
     for (; it != it_end; ++it) {
@@ -53,14 +136,118 @@ void AutoReloadHelper::addFile(const std::string& file) {
         return;
     std::string expanded_file = StringUtil::expandFilename(file);
     m_timestamps[expanded_file] = FileUtil::getLastStatusChangeTimestamp(expanded_file.c_str());
+
+    void (*read_events)() = &AutoReloadHelper::readEvents;
+    RefCount<Slot<void> > handler(new SlotImpl<void (*)(), void>(read_events));
+    if (!watch(expanded_file, handler))
+        m_poll = true;
+    else // it's being read as it is now, or was just written by us
+        readEvents(expanded_file);
 }
 
 void AutoReloadHelper::reload() {
-    if (!m_reload_cmd.get())
-        return;
     m_timestamps.clear();
+    m_poll = false;
+    m_changed = false;
     addFile(m_main_file);
-    m_reload_cmd->execute();
+    if (m_reload_cmd.get())
+        m_reload_cmd->execute();
+}
+
+bool AutoReloadHelper::watches(const std::string &path, bool dir_event) const {
+    if (m_timestamps.find(path) != m_timestamps.end())
+        return true;
+    if (!dir_event)
+        return false;
+    // the directory went away, and with it the files in there
+    TimestampMap::const_iterator it = m_timestamps.begin();
+    for (; it != m_timestamps.end(); ++it) {
+        if (it->first.compare(0, path.size() + 1, path + "/") == 0)
+            return true;
+    }
+    return false;
+}
+
+void AutoReloadHelper::readEvents() {
+    readEvents(std::string());
+}
+
+void AutoReloadHelper::readEvents(const std::string &written) {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (s_inotify < 0)
+        return;
+
+    // aligned for struct inotify_event
+    static long buffer[1024];
+    bool changed = false;
+    ssize_t size;
+    while ((size = read(s_inotify, buffer, sizeof(buffer))) > 0) {
+        const char *data = reinterpret_cast<const char *>(buffer);
+        for (ssize_t pos = 0; pos < size; ) {
+            const struct inotify_event *event =
+                reinterpret_cast<const struct inotify_event *>(data + pos);
+            pos += sizeof(struct inotify_event) + event->len;
+
+            std::set<AutoReloadHelper *>::iterator it = s_helpers.begin();
+            if (event->mask & IN_Q_OVERFLOW) {
+                // lost track, so everything may have changed
+                for (; it != s_helpers.end(); ++it)
+                    (*it)->m_changed = true;
+                changed = true;
+                continue;
+            }
+
+            std::map<int, std::string>::iterator dir = s_watched_dirs.find(event->wd);
+            if (dir == s_watched_dirs.end())
+                continue;
+
+            const std::string dirname = dir->second;
+            const bool gone = (event->mask & IN_IGNORED) != 0;
+            if (gone)
+                s_watched_dirs.erase(dir);
+
+            const std::string path = event->len > 0 ? dirname + "/" + event->name : dirname;
+            if (path == written)
+                continue;
+
+            for (; it != s_helpers.end(); ++it) {
+                // a change in a watched directory is a change of it
+                if ((*it)->watches(path, gone) ||
+                    (event->len > 0 && (*it)->watches(dirname, false))) {
+                    (*it)->m_changed = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    if (changed) {
+        Timer &timer = settleTimer();
+        if (!timer.isTiming()) {
+            timer.setTimeout(SETTLE_TIME);
+            timer.fireOnce(true);
+            timer.setFunctor(&AutoReloadHelper::reloadChanged);
+        }
+        // wait until it's quiet again
+        timer.stop();
+        timer.start();
+    }
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void AutoReloadHelper::reloadChanged() {
+    std::vector<AutoReloadHelper *> changed;
+    std::set<AutoReloadHelper *>::iterator it = s_helpers.begin();
+    for (; it != s_helpers.end(); ++it) {
+        if ((*it)->m_changed)
+            changed.push_back(*it);
+    }
+
+    for (size_t i = 0; i < changed.size(); ++i) {
+        // a reload may delete other helpers, like the ones of submenus
+        if (s_helpers.find(changed[i]) != s_helpers.end() && changed[i]->m_changed)
+            changed[i]->reload();
+    }
 }
 
 } // end namespace FbTk
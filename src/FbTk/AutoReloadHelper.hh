@@ -27,12 +27,24 @@
 #include <sys/types.h>
 
 #include "Command.hh"
+#include "NotCopyable.hh"
 #include "RefCount.hh"
 
 namespace FbTk {
 
-class AutoReloadHelper {
+/**
+ * Runs a reload command when the main file, or one of the files added
+ * while loading it, changes.
+ *
+ * With inotify, the directories of the files are watched from the main
+ * loop and the command runs on its own once the changes settle. Without
+ * it, or for files that can't be watched, checkReload() compares their
+ * timestamps.
+ */
+class AutoReloadHelper: private NotCopyable {
 public:
+    AutoReloadHelper();
+    ~AutoReloadHelper();
 
     void setMainFile(const std::string& filename);
     void addFile(const std::string& filename);
@@ -42,11 +54,22 @@ public:
     void reload();
 
 private:
+    /// reads what inotify has
+    static void readEvents();
+    /// reads what inotify has, ignoring the changes to the written file
+    static void readEvents(const std::string &written);
+    /// reloads the helpers whose files changed
+    static void reloadChanged();
+
+    bool watches(const std::string &path, bool dir_event) const;
+
     RefCount<Command<void> > m_reload_cmd;
     std::string m_main_file;
 
     typedef std::map<std::string, time_t> TimestampMap;
     TimestampMap m_timestamps;
+    bool m_poll;    ///< some file isn't watched, compare the timestamps
+    bool m_changed; ///< a watched file changed
 };
 
 } // end namespace FbTk
@@ -203,9 +203,14 @@ void FbWindow::updateBackground(bool only_if_alpha) {
         if (m_lastbg_pm == None && m_lastbg_color_set) {
             XSetForeground(display(), gc, m_lastbg_color);
             newpm.fillRectangle(gc, 0, 0, width(), height());
+        } else if (m_lastbg_pm != None) {
+            // the background may be a strip narrower than the window
+            XSetTile(display(), gc, m_lastbg_pm);
+            XSetFillStyle(display(), gc, FillTiled);
+            newpm.fillRectangle(gc, 0, 0, width(), height());
         } else {
             // copy from window if no color and no bg...
-            newpm.copyArea((m_lastbg_pm == None)?drawable():m_lastbg_pm, gc, 0, 0, 0, 0, width(), height());
+            newpm.copyArea(drawable(), gc, 0, 0, 0, 0, width(), height());
         }
         XFreeGC(display(), gc);
 
@@ -25,6 +25,7 @@
 #include "stringstream.hh"
 #include "App.hh"
 #include "GContext.hh"
+#include "TextUtils.hh"
 #include "XFontImp.hh"
 
 // for antialias
@@ -145,6 +146,7 @@ Font::Font(const char *name):
 }
 
 Font::~Font() {
+    forgetTextLayouts(*this);
 }
 
 bool Font::load(const string &name) {
@@ -152,6 +154,8 @@ bool Font::load(const string &name) {
     if (name.empty())
         return false;
 
+    forgetTextLayouts(*this);
+
     StringMapIt lookup_entry;
     FontCacheIt cache_entry;
 
@@ -247,6 +251,10 @@ unsigned int Font::textWidth(const BiDiString &text) const {
     return textWidth(text.visual().c_str(), text.visual().size());
 }
 
+bool Font::fitText(const char* text, unsigned int &size, int max_width, int &width) const {
+    return m_fontimp->fitText(text, size, max_width, width);
+}
+
 unsigned int Font::height() const {
     return m_fontimp->height();
 }
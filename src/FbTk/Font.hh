@@ -75,6 +75,8 @@ public:
     */
     unsigned int textWidth(const char* text, unsigned int size) const;
     unsigned int textWidth(const BiDiString &text) const;
+    /// @see FontImp::fitText()
+    bool fitText(const char* text, unsigned int &size, int max_width, int &width) const;
 
     unsigned int height() const;
     int ascent() const;
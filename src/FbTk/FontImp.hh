@@ -42,6 +42,14 @@ public:
     virtual bool load(const std::string &name) = 0;
     virtual void drawText(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient) = 0;
     virtual unsigned int textWidth(const char* text, unsigned int len) const = 0;
+    /**
+       Measures the longest start of text that is at most max_width wide,
+       for fonts that can do it in one pass.
+       @param len in: bytes of text, out: bytes that fit
+       @param width out: width of what fits
+       @return false if it's left to searching with textWidth()
+    */
+    virtual bool fitText(const char* text, unsigned int &len, int max_width, int &width) const { return false; }
     virtual bool validOrientation(FbTk::Orientation orient) { return orient == ROT0; }
     virtual int ascent() const = 0;
     virtual int descent() const = 0;
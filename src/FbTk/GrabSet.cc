@@ -0,0 +1,135 @@
+// GrabSet.cc for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "GrabSet.hh"
+#include "KeyUtil.hh"
+#include "App.hh"
+
+#include <algorithm>
+
+namespace FbTk {
+
+bool GrabSet::Grab::operator < (const Grab &other) const {
+    if (win != other.win)
+        return win < other.win;
+    if (button != other.button)
+        return button < other.button;
+    if (code != other.code)
+        return code < other.code;
+    if (mod != other.mod)
+        return mod < other.mod;
+    return event_mask < other.event_mask;
+}
+
+void GrabSet::clearWanted(Window win) {
+    Grab first = { win, false, 0, 0, 0 };
+    Grabs::iterator it = m_wanted.lower_bound(first);
+    while (it != m_wanted.end() && it->win == win)
+        m_wanted.erase(it++);
+}
+
+void GrabSet::wantKey(unsigned int key, unsigned int mod, Window win) {
+    Grab grab = { win, false, key, mod, 0 };
+    want(grab);
+}
+
+void GrabSet::wantButton(unsigned int button, unsigned int mod, Window win,
+                         unsigned int event_mask) {
+    Grab grab = { win, true, button, mod, event_mask };
+    want(grab);
+}
+
+void GrabSet::want(Grab grab) {
+    const unsigned int nummod = KeyUtil::instance().numlock();
+    const unsigned int scrollmod = KeyUtil::instance().scrolllock();
+    const unsigned int mod = grab.mod;
+
+    // the same combinations KeyUtil::grabKey() grabs
+    for (int i = 0; i < 8; i++) {
+        grab.mod = mod | (i & 1 ? LockMask : 0) |
+            (i & 2 ? nummod : 0) | (i & 4 ? scrollmod : 0);
+        m_wanted.insert(grab);
+    }
+}
+
+void GrabSet::commit(std::vector<Window> &reset) {
+    reset.clear();
+    Display *display = App::instance()->display();
+
+    // both sets are ordered, walk them side by side
+    std::vector<Grab> added;
+    Grabs::iterator cur = m_current.begin(), wanted = m_wanted.begin();
+    while (cur != m_current.end() || wanted != m_wanted.end()) {
+        if (cur == m_current.end() ||
+            (wanted != m_wanted.end() && *wanted < *cur)) {
+            added.push_back(*wanted++);
+            continue;
+        }
+        if (wanted != m_wanted.end() && !(*cur < *wanted)) { // in place already
+            ++cur;
+            ++wanted;
+            continue;
+        }
+
+        // *cur isn't wanted anymore
+        if (!cur->button) {
+            XUngrabKey(display, cur->code, cur->mod, cur->win);
+            m_current.erase(cur++);
+            continue;
+        }
+
+        // buttons sort after keys, so all that is left of the window in
+        // either set are buttons
+        const Window win = cur->win;
+        XUngrabButton(display, AnyButton, AnyModifier, win);
+        reset.push_back(win);
+        while (cur != m_current.end() && cur->win == win)
+            m_current.erase(cur++);
+        while (wanted != m_wanted.end() && wanted->win == win)
+            ++wanted;
+    }
+
+    for (size_t i = 0; i < added.size(); ++i) {
+        const Grab &g = added[i];
+        if (g.button) {
+            // a reset window gets its buttons back on the next commit()
+            if (std::find(reset.begin(), reset.end(), g.win) != reset.end())
+                continue;
+            XGrabButton(display, g.code, g.mod, g.win, False, g.event_mask,
+                        GrabModeSync, GrabModeAsync, None, None);
+        } else
+            XGrabKey(display, g.code, g.mod, g.win, True,
+                     GrabModeAsync, GrabModeSync);
+        m_current.insert(g);
+    }
+
+    XFlush(display);
+}
+
+void GrabSet::forget(Window win) {
+    clearWanted(win);
+    Grab first = { win, false, 0, 0, 0 };
+    Grabs::iterator it = m_current.lower_bound(first);
+    while (it != m_current.end() && it->win == win)
+        m_current.erase(it++);
+}
+
+} // end namespace FbTk
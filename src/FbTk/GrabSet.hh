@@ -0,0 +1,83 @@
+// GrabSet.hh for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FBTK_GRABSET_HH
+#define FBTK_GRABSET_HH
+
+#include <X11/Xlib.h>
+
+#include <set>
+#include <vector>
+
+namespace FbTk {
+
+/**
+ * The passive key and button grabs held on a number of windows.
+ *
+ * The grabs that should be in place are collected with want*(), commit()
+ * then compares them to the grabs already in place and only sends the
+ * difference, without waiting for the server. Every grab is kept with
+ * the lock modifier combinations KeyUtil::grabKey() adds, so a changed
+ * NumLock or ScrollLock mapping shows up in the difference as well.
+ */
+class GrabSet {
+public:
+    /// forgets what was wanted so far, to collect the grabs from scratch
+    void clearWanted() { m_wanted.clear(); }
+    /// forgets what was wanted for one window
+    void clearWanted(Window win);
+
+    void wantKey(unsigned int key, unsigned int mod, Window win);
+    void wantButton(unsigned int button, unsigned int mod, Window win,
+                    unsigned int event_mask);
+
+    /**
+     * Makes the grabs in place match the wanted ones.
+     * Button grabs are not taken away one by one, since that would cut
+     * holes into AnyModifier grabs others hold on the window; the windows
+     * in @a reset lost all their button grabs instead, the caller has to
+     * restore its own ones and call commit() again for the others.
+     */
+    void commit(std::vector<Window> &reset);
+
+    /// the window is gone or had its grabs removed, forget about it
+    void forget(Window win);
+
+private:
+    struct Grab {
+        Window win;
+        bool button;
+        unsigned int code; ///< keycode or button number
+        unsigned int mod;
+        unsigned int event_mask;
+
+        bool operator < (const Grab &other) const;
+    };
+    typedef std::set<Grab> Grabs;
+
+    void want(Grab grab);
+
+    Grabs m_wanted, m_current;
+};
+
+} // end namespace FbTk
+
+#endif // FBTK_GRABSET_HH
@@ -25,6 +25,7 @@
 #include "App.hh"
 #include "FbWindow.hh"
 #include "MultLayers.hh"
+#include "StackDiff.hh"
 
 #include <iostream>
 #include <algorithm>
@@ -74,13 +75,31 @@ void extract_windows_to_stack(const FbTk::Layer::ItemList& items, LayerItem* tem
     }
 }
 
-void restack(const FbTk::Layer::ItemList& items, LayerItem* temp_raised) {
+// Tells the server about the new stacking order 'stack' (top first), where
+// 'stacked' is the order it knows. Only the windows that are out of place
+// get moved, unless that is most of them anyway: then one XRestackWindows
+// is cheaper.
+void sendStack(const std::vector<Window>& stacked, std::vector<Window>& stack) {
 
-    std::vector<Window> stack;
-    extract_windows_to_stack(items, temp_raised, stack);
+    if (stack.empty())
+        return;
 
-    if (!stack.empty())
-        XRestackWindows(FbTk::App::instance()->display(), &stack[0], stack.size());
+    std::vector<FbTk::StackMove<Window> > moves;
+    FbTk::diffStack(stacked, stack, moves);
+
+    Display* disp = FbTk::App::instance()->display();
+    if (moves.size() * 2 > stack.size()) {
+        XRestackWindows(disp, &stack[0], stack.size());
+        return;
+    }
+
+    XWindowChanges changes;
+    std::vector<FbTk::StackMove<Window> >::const_iterator it = moves.begin();
+    for (; it != moves.end(); ++it) {
+        changes.sibling = it->sibling;
+        changes.stack_mode = it->above ? Above : Below;
+        XConfigureWindow(disp, it->window, CWSibling | CWStackMode, &changes);
+    }
 }
 
 } // end of anonymous namespace
@@ -88,14 +107,22 @@ void restack(const FbTk::Layer::ItemList& items, LayerItem* temp_raised) {
 
 void Layer::restack(const std::vector<Layer*>& layers) {
 
-    std::vector<Window> stack;
+    std::vector<Window> stacked, stack;
+    std::vector<size_t> ends;
     std::vector<Layer*>::const_iterator l;
     for (l = layers.begin(); l != layers.end(); ++l) {
+        stacked.insert(stacked.end(), (*l)->m_stack.begin(), (*l)->m_stack.end());
         extract_windows_to_stack((*l)->itemList(), 0, stack);
+        ends.push_back(stack.size());
     }
 
-    if (!stack.empty())
-        XRestackWindows(FbTk::App::instance()->display(), &stack[0], stack.size());
+    sendStack(stacked, stack);
+
+    size_t start = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        layers[i]->m_stack.assign(stack.begin() + start, stack.begin() + ends[i]);
+        start = ends[i];
+    }
 }
 
 Layer::Layer(MultLayers &manager, int layernum):
@@ -108,13 +135,19 @@ Layer::~Layer() {
 
 void Layer::restack() {
     if (m_manager.isUpdatable()) {
-        ::restack(itemList(), 0);
+        std::vector<Window> stack;
+        extract_windows_to_stack(itemList(), 0, stack);
+        sendStack(m_stack, stack);
+        m_stack.swap(stack);
         m_needs_restack = false;
     }
 }
 
 void Layer::restackAndTempRaise(LayerItem &item) {
-    ::restack(itemList(), &item);
+    std::vector<Window> stack;
+    extract_windows_to_stack(itemList(), &item, stack);
+    sendStack(m_stack, stack);
+    m_stack.swap(stack);
 }
 
 int Layer::countWindows() {
@@ -133,6 +166,7 @@ void Layer::stackBelowItem(LayerItem &item, LayerItem *above) {
     // windows to get pushed to the bottom
     if (!above || m_needs_restack) { // must need to go right to top
         restack();
+        m_manager.stackingSig().emit(&item);
         return;
     }
 
@@ -147,6 +181,24 @@ void Layer::stackBelowItem(LayerItem &item, LayerItem *above) {
     extract_windows_to_stack(item.getWindows(), stack);
 
     XRestackWindows(FbTk::App::instance()->display(), &stack[0], stack.size());
+
+    // keep track of where the item's windows went
+    for (size_t i = 1; i < stack.size(); ++i)
+        m_stack.erase(std::remove(m_stack.begin(), m_stack.end(), stack[i]), m_stack.end());
+
+    std::vector<Window>::iterator pos = m_stack.begin();
+    if (&above->getLayer() == this) {
+        pos = std::find(m_stack.begin(), m_stack.end(), stack[0]);
+        if (pos == m_stack.end()) {
+            // we lost track, the next restack has to start from scratch
+            m_stack.clear();
+            m_manager.stackingSig().emit(&item);
+            return;
+        }
+        ++pos;
+    }
+    m_stack.insert(pos, stack.begin() + 1, stack.end());
+    m_manager.stackingSig().emit(&item);
 }
 
 // We can't just use Restack here, because it won't do anything if they're
@@ -197,6 +249,8 @@ void Layer::remove(LayerItem &item) {
     for (; it != it_end; ++it) {
         if (*it == &item) {
             itemList().erase(it);
+            if (m_manager.isUpdatable())
+                m_manager.stackingSig().emit(&item);
             break;
         }
     }
@@ -23,6 +23,8 @@
 #ifndef FBTK_LAYER_HH
 #define FBTK_LAYER_HH
 
+#include <X11/X.h>
+
 #include <vector>
 #include <list>
 
@@ -78,6 +80,9 @@ private:
     int m_layernum;
     bool m_needs_restack;
     ItemList m_items;
+    /// our windows in the order the server knows, top first, so they must
+    /// not be restacked behind our back, but through their LayerItem
+    std::vector<Window> m_stack;
 };
 
 } // namespace FbTk
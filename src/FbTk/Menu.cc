@@ -371,6 +371,7 @@ void Menu::enterSubmenu() {
     if (submenu == 0)
         return;
 
+    submenu->populate();
     if (submenu->m_items.empty())
         return;
 
@@ -521,6 +522,7 @@ void Menu::updateMenu() {
 
 void Menu::show() {
 
+    populate();
     if (isVisible() || m_items.empty())
         return;
 
@@ -689,6 +691,8 @@ void Menu::drawSubmenu(unsigned int index) {
     if (item->submenu() && isVisible() && (! item->submenu()->isTorn()) &&
         item->isEnabled()) {
 
+        item->submenu()->populate();
+
         if (item->submenu()->m_parent != this)
             item->submenu()->m_parent = this;
 
@@ -1232,10 +1236,13 @@ void Menu::themeReconfigured() {
 
     m_need_update = true;
 
-    size_t l = m_items.size();
-    size_t i;
-    for (i = 0; i < l; i++) {
-        m_items[i]->updateTheme(theme());
+    // the icons are read again for new sizes, not for new colors
+    if (!theme()->onlyColorsChanged()) {
+        size_t l = m_items.size();
+        size_t i;
+        for (i = 0; i < l; i++) {
+            m_items[i]->updateTheme(theme());
+        }
     }
     reconfigure();
 }
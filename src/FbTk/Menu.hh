@@ -110,6 +110,8 @@ public:
     void setItemEnabled(unsigned int index, bool val);
     void setMinimumColumns(int columns) { m_min_columns = columns; }
     virtual void drawSubmenu(unsigned int index);
+    /// a menu that makes its items on demand makes them here, before it's shown
+    virtual void populate() { }
     virtual void show();
     virtual void hide(bool force = false);
     virtual void clearWindow();
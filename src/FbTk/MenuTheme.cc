@@ -108,6 +108,14 @@ MenuTheme::~MenuTheme() {
 
 }
 
+bool MenuTheme::onlyColorsChanged() const {
+    const ThemeItem_base *colors[] = {
+        &t_text, &f_text, &h_text, &d_text, &u_text,
+        &title, &frame, &hilite, &m_border_color
+    };
+    return onlyChanged(colors, sizeof(colors) / sizeof(colors[0]));
+}
+
 void MenuTheme::reconfigTheme() {
     // clamp to "normal" size
     if (*m_bevel_width > 20)
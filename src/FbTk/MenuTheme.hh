@@ -111,8 +111,15 @@ public:
     unsigned int borderWidth() const { return *m_border_width; }
     unsigned int bevelWidth() const { return *m_bevel_width; }
 
+    /// @return true if the last load that changed the theme only changed colors
+    bool onlyColorsChanged() const;
+
     unsigned char alpha() const { return m_alpha; }
-    void setAlpha(int alpha) { m_alpha = alpha; }
+    void setAlpha(int alpha) {
+        if (alpha != m_alpha)
+            setChanged();
+        m_alpha = alpha;
+    }
     // this isn't actually a theme item
     // but we'll let it be here for now, until there's a better way to
     // get resources into menu
@@ -60,7 +60,9 @@ LayerItem *MultLayers::getLowestItemAboveLayer(int layernum) {
 void MultLayers::addToTop(LayerItem &item, int layernum) {
     layernum = FbTk::Util::clamp(layernum, 0, static_cast<signed>(m_layers.size()) - 1);
     m_layers[layernum]->insert(item);
-    restack();
+    // the insert told where the item went
+    if (isUpdatable())
+        Layer::restack(m_layers);
 }
 
 
@@ -115,6 +117,7 @@ void MultLayers::restack() {
         return;
 
     Layer::restack(m_layers);
+    m_stacking_sig.emit(0);
 }
 
 int MultLayers::size() {
@@ -23,6 +23,8 @@
 #ifndef FBTK_MULTLAYERS_HH
 #define FBTK_MULTLAYERS_HH
 
+#include "Signal.hh"
+
 #include <vector>
 #include <cstdlib> // size_t
 
@@ -57,6 +59,12 @@ public:
     Layer *getLayer(size_t num);
     const Layer *getLayer(size_t num) const;
 
+    /**
+     * Emitted with an item that moved to another place in the layers,
+     * or with 0 when any of them might have.
+     */
+    Signal<LayerItem *> &stackingSig() { return m_stacking_sig; }
+
     bool isUpdatable() const { return m_lock == 0; }
     void lock() { ++m_lock; }
     void unlock() { if (--m_lock == 0) restack(); }
@@ -66,6 +74,7 @@ private:
 
     std::vector<Layer *> m_layers;
     int m_lock;
+    Signal<LayerItem *> m_stacking_sig;
 };
 
 }
@@ -19,16 +19,405 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
-
 #include "RegExp.hh"
 
-#include <iostream>
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <vector>
 
 using std::string;
 
 #ifdef USE_REGEXP
-using std::cerr;
-using std::endl;
+
+namespace {
+
+bool isSpecial(char c) {
+    static const char special[] = ".[]()*+?{}|^$\\";
+    return c != 0 && strchr(special, c) != 0;
+}
+
+// an extended regular expression made of plain and escaped special
+// characters only matches one string
+bool parseLiteral(const string &str, string &literal) {
+
+    literal.clear();
+    for (size_t i = 0; i < str.size(); ++i) {
+        char c = str[i];
+        if (c == '\\') {
+            if (++i == str.size() || !isSpecial(str[i]))
+                return false;
+            c = str[i];
+        } else if (c == 0 || isSpecial(c))
+            return false;
+        literal += c;
+    }
+    return true;
+}
+
+bool startsWithAny(const string &str) {
+    return str.size() >= 2 && str[0] == '.' && str[1] == '*';
+}
+
+bool endsWithAny(const string &str, size_t from) {
+    return str.size() >= from + 2 && str[str.size() - 2] == '.' && str[str.size() - 1] == '*';
+}
+
+} // end of anonymous namespace
+
+namespace FbTk {
+
+/*
+  The automaton for full match expressions. The expression is parsed into
+  an NFA (Thompson's construction), the DFA states are the sets of NFA
+  nodes that are reached, and are only created when a string runs into
+  them. Bytes that no node tells apart share one column in the
+  transition table.
+*/
+class RegExp::Dfa {
+public:
+    /// @return 0 if the expression uses something the automaton can't do
+    static Dfa *create(const string &str);
+
+    /**
+     * @param result is set to whether the string matches
+     * @return false if the POSIX matcher has to decide
+     */
+    bool match(const string &str, bool &result);
+
+private:
+    enum { MAX_STATES = 128 };
+
+    typedef std::bitset<256> CharSet;
+
+    struct Node {
+        Node(): consumes(false), next1(-1), next2(-1) { }
+        bool consumes; ///< a byte in 'chars', or an epsilon move
+        CharSet chars;
+        int next1, next2;
+    };
+
+    struct Fragment {
+        int start, end;
+    };
+
+    Dfa(): m_start(-1), m_end(-1), m_multibyte_safe(true), m_num_classes(0), m_dead(-1) { }
+
+    int newNode() { m_nodes.push_back(Node()); return m_nodes.size() - 1; }
+    void link(int from, int to);
+    Fragment charFragment(const CharSet &chars);
+
+    bool parseRegex(const string &s, size_t &pos, Fragment &f, bool top);
+    bool parseBranch(const string &s, size_t &pos, Fragment &f);
+    bool parsePiece(const string &s, size_t &pos, Fragment &f);
+    bool parseAtom(const string &s, size_t &pos, Fragment &f);
+    bool parseBracket(const string &s, size_t &pos, CharSet &chars);
+
+    void buildClasses();
+    int state(const std::vector<int> &seeds);
+    int step(int from, int byte_class);
+
+    std::vector<Node> m_nodes;
+    int m_start, m_end;
+    /// without '.' and bracket expressions, bytes and characters match the same
+    bool m_multibyte_safe;
+
+    unsigned char m_class[256];       ///< byte -> column
+    std::vector<unsigned char> m_rep; ///< column -> a byte of it
+    size_t m_num_classes;
+
+    typedef std::map<std::vector<int>, int> StateIds;
+    StateIds m_state_ids;             ///< NFA nodes (+ -1 if accepting) -> state
+    std::vector<std::vector<int> > m_state_nodes;
+    std::vector<bool> m_accepts;
+    std::vector<int> m_next;          ///< state * m_num_classes + column, -1 unknown
+    int m_dead;
+};
+
+RegExp::Dfa *RegExp::Dfa::create(const string &str) {
+    Dfa *dfa = new Dfa();
+    size_t pos = 0;
+    Fragment f;
+    if (!dfa->parseRegex(str, pos, f, true) || pos != str.size()) {
+        delete dfa;
+        return 0;
+    }
+    dfa->m_start = f.start;
+    dfa->m_end = f.end;
+    dfa->buildClasses();
+    return dfa;
+}
+
+void RegExp::Dfa::link(int from, int to) {
+    if (m_nodes[from].next1 < 0)
+        m_nodes[from].next1 = to;
+    else
+        m_nodes[from].next2 = to;
+}
+
+RegExp::Dfa::Fragment RegExp::Dfa::charFragment(const CharSet &chars) {
+    Fragment f = { newNode(), newNode() };
+    m_nodes[f.start].consumes = true;
+    m_nodes[f.start].chars = chars;
+    link(f.start, f.end);
+    return f;
+}
+
+// regex := branch ('|' branch)*
+bool RegExp::Dfa::parseRegex(const string &s, size_t &pos, Fragment &f, bool top) {
+    if (!parseBranch(s, pos, f))
+        return false;
+
+    while (pos < s.size() && s[pos] == '|') {
+        // the full match anchors bind tighter than a top level '|'
+        if (top)
+            return false;
+        ++pos;
+        Fragment other;
+        if (!parseBranch(s, pos, other))
+            return false;
+        Fragment alt = { newNode(), newNode() };
+        link(alt.start, f.start);
+        link(alt.start, other.start);
+        link(f.end, alt.end);
+        link(other.end, alt.end);
+        f = alt;
+    }
+    return true;
+}
+
+// branch := piece+
+bool RegExp::Dfa::parseBranch(const string &s, size_t &pos, Fragment &f) {
+    bool empty = true;
+    while (pos < s.size() && s[pos] != '|' && s[pos] != ')') {
+        Fragment piece;
+        if (!parsePiece(s, pos, piece))
+            return false;
+        if (empty)
+            f = piece;
+        else {
+            link(f.end, piece.start);
+            f.end = piece.end;
+        }
+        empty = false;
+    }
+    return !empty;
+}
+
+// piece := atom ('*' | '+' | '?')?
+bool RegExp::Dfa::parsePiece(const string &s, size_t &pos, Fragment &f) {
+    if (!parseAtom(s, pos, f))
+        return false;
+    if (pos == s.size())
+        return true;
+
+    const char op = s[pos];
+    if (op == '*') {
+        Fragment star = { newNode(), newNode() };
+        link(star.start, f.start);
+        link(star.start, star.end);
+        link(f.end, f.start);
+        link(f.end, star.end);
+        f = star;
+    } else if (op == '+') {
+        int end = newNode();
+        link(f.end, f.start);
+        link(f.end, end);
+        f.end = end;
+    } else if (op == '?') {
+        Fragment opt = { newNode(), newNode() };
+        link(opt.start, f.start);
+        link(opt.start, opt.end);
+        link(f.end, opt.end);
+        f = opt;
+    } else
+        return true;
+
+    ++pos;
+    // stacked operators are left to POSIX
+    return pos == s.size() || (s[pos] != '*' && s[pos] != '+' && s[pos] != '?');
+}
+
+// atom := char | '\' special | '.' | bracket | '(' regex ')'
+bool RegExp::Dfa::parseAtom(const string &s, size_t &pos, Fragment &f) {
+    const char c = s[pos];
+    CharSet chars;
+
+    if (c == '(') {
+        ++pos;
+        if (!parseRegex(s, pos, f, false) || pos == s.size() || s[pos] != ')')
+            return false;
+        ++pos;
+        return true;
+    } else if (c == '.') {
+        chars.set();
+        chars.reset(0);
+        m_multibyte_safe = false;
+        ++pos;
+    } else if (c == '[') {
+        if (!parseBracket(s, pos, chars))
+            return false;
+        m_multibyte_safe = false;
+    } else if (c == '\\') {
+        // GNU escapes like \w or \b and back references are left to POSIX
+        if (pos + 1 == s.size() || !isSpecial(s[pos + 1]))
+            return false;
+        chars.set(static_cast<unsigned char>(s[pos + 1]));
+        pos += 2;
+    } else if (c == 0 || isSpecial(c) || (c & 0x80))
+        return false; // anchors, intervals, and characters of more than one byte
+    else {
+        chars.set(static_cast<unsigned char>(c));
+        ++pos;
+    }
+
+    f = charFragment(chars);
+    return true;
+}
+
+// only plain characters and ranges within digits, lower or upper case
+// letters, since the locale decides about everything else
+bool RegExp::Dfa::parseBracket(const string &s, size_t &pos, CharSet &chars) {
+    ++pos;
+    bool negate = false;
+    if (pos < s.size() && s[pos] == '^') {
+        negate = true;
+        ++pos;
+    }
+    if (pos < s.size() && s[pos] == ']')
+        return false;
+
+    while (pos < s.size() && s[pos] != ']') {
+        const unsigned char c = s[pos];
+        if (c == 0 || c == '[' || c == '\\' || (c & 0x80))
+            return false;
+
+        if (pos + 2 < s.size() && s[pos + 1] == '-' && s[pos + 2] != ']') {
+            const unsigned char d = s[pos + 2];
+            if (d < c || !((isdigit(c) && isdigit(d)) ||
+                           (islower(c) && islower(d)) ||
+                           (isupper(c) && isupper(d))))
+                return false;
+            for (unsigned int i = c; i <= d; ++i)
+                chars.set(i);
+            pos += 3;
+        } else {
+            chars.set(c);
+            ++pos;
+        }
+    }
+    if (pos == s.size())
+        return false;
+    ++pos;
+
+    if (negate) {
+        chars.flip();
+        chars.reset(0);
+    }
+    return true;
+}
+
+void RegExp::Dfa::buildClasses() {
+    std::map<std::vector<bool>, unsigned char> classes;
+    for (int byte = 0; byte < 256; ++byte) {
+        std::vector<bool> signature(m_nodes.size());
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+            signature[i] = m_nodes[i].consumes && m_nodes[i].chars.test(byte);
+
+        std::map<std::vector<bool>, unsigned char>::iterator it = classes.find(signature);
+        if (it == classes.end()) {
+            it = classes.insert(std::make_pair(signature, static_cast<unsigned char>(m_rep.size()))).first;
+            m_rep.push_back(byte);
+        }
+        m_class[byte] = it->second;
+    }
+    m_num_classes = m_rep.size();
+}
+
+// the state for the epsilon closure of the seed nodes
+int RegExp::Dfa::state(const std::vector<int> &seeds) {
+    std::vector<bool> seen(m_nodes.size(), false);
+    std::vector<int> stack(seeds), nodes;
+    bool accepts = false;
+    while (!stack.empty()) {
+        int n = stack.back();
+        stack.pop_back();
+        if (n < 0 || seen[n])
+            continue;
+        seen[n] = true;
+        if (n == m_end)
+            accepts = true;
+        if (m_nodes[n].consumes)
+            nodes.push_back(n);
+        else {
+            stack.push_back(m_nodes[n].next1);
+            stack.push_back(m_nodes[n].next2);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    if (accepts)
+        nodes.push_back(-1);
+
+    StateIds::iterator it = m_state_ids.find(nodes);
+    if (it != m_state_ids.end())
+        return it->second;
+
+    int id = m_state_nodes.size();
+    m_state_ids[nodes] = id;
+    if (accepts)
+        nodes.pop_back();
+    if (nodes.empty() && !accepts)
+        m_dead = id;
+    m_state_nodes.push_back(nodes);
+    m_accepts.push_back(accepts);
+    m_next.resize(m_next.size() + m_num_classes, -1);
+    return id;
+}
+
+int RegExp::Dfa::step(int from, int byte_class) {
+    const unsigned char byte = m_rep[byte_class];
+    std::vector<int> seeds;
+    for (size_t i = 0; i < m_state_nodes[from].size(); ++i) {
+        const Node &node = m_nodes[m_state_nodes[from][i]];
+        if (node.chars.test(byte))
+            seeds.push_back(node.next1);
+    }
+    int to = state(seeds);
+    m_next[from * m_num_classes + byte_class] = to;
+    return to;
+}
+
+bool RegExp::Dfa::match(const string &str, bool &result) {
+    if (m_state_nodes.empty())
+        state(std::vector<int>(1, m_start));
+
+    int current = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        const unsigned char byte = str[i];
+        if ((byte & 0x80) && !m_multibyte_safe)
+            return false;
+
+        const int column = m_class[byte];
+        int next = m_next[current * m_num_classes + column];
+        if (next < 0) {
+            if (m_state_nodes.size() >= MAX_STATES)
+                return false;
+            next = step(current, column);
+        }
+        if (next == m_dead) {
+            result = false;
+            return true;
+        }
+        current = next;
+    }
+    result = m_accepts[current];
+    return true;
+}
+
+} // end namespace FbTk
+
 #endif // USE_REGEXP
 
 namespace FbTk {
@@ -37,22 +426,31 @@ namespace FbTk {
 // or just a substring. Substrings aren't supported if not HAVE_REGEXP
 RegExp::RegExp(const string &str, bool full_match):
 #ifdef USE_REGEXP
+m_kind(POSIX),
+m_dfa(0),
 m_regex(0) {
-    string match;
     if (full_match) {
-        match = "^";
-        match.append(str);
-        match.append("$");
+        m_posix_str = "^";
+        m_posix_str.append(str);
+        m_posix_str.append("$");
+
+        const bool lead = startsWithAny(str);
+        const bool trail = endsWithAny(str, lead ? 2 : 0);
+        if (parseLiteral(str, m_literal))
+            m_kind = LITERAL;
+        else if ((lead || trail) &&
+                 parseLiteral(str.substr(lead ? 2 : 0, str.size() - (lead ? 2 : 0) - (trail ? 2 : 0)), m_literal))
+            m_kind = lead ? (trail ? INFIX : SUFFIX) : PREFIX;
+        else if ((m_dfa = Dfa::create(str)) != 0)
+            m_kind = AUTOMATON;
     } else {
-        match = str;
+        m_posix_str = str;
+        if (parseLiteral(str, m_literal))
+            m_kind = INFIX;
     }
 
-    m_regex = new regex_t;
-    int ret = regcomp(m_regex, match.c_str(), REG_NOSUB | REG_EXTENDED);
-    if (ret != 0) {
-        delete m_regex; // I don't think I regfree a failed compile?
-        m_regex = 0;
-    }
+    if (m_kind == POSIX)
+        compilePosix();
 }
 #else // notdef USE_REGEXP
 m_str(str) {}
@@ -60,6 +458,7 @@ m_str(str) {}
 
 RegExp::~RegExp() {
 #ifdef USE_REGEXP
+    delete m_dfa;
     if (m_regex != 0) {
         regfree(m_regex);
         delete m_regex;
@@ -67,8 +466,43 @@ RegExp::~RegExp() {
 #endif // USE_REGEXP
 }
 
+#ifdef USE_REGEXP
+bool RegExp::compilePosix() const {
+    m_regex = new regex_t;
+    int ret = regcomp(m_regex, m_posix_str.c_str(), REG_NOSUB | REG_EXTENDED);
+    if (ret != 0) {
+        delete m_regex; // I don't think I regfree a failed compile?
+        m_regex = 0;
+    }
+    return m_regex != 0;
+}
+#endif // USE_REGEXP
+
 bool RegExp::match(const string &str) const {
 #ifdef USE_REGEXP
+    const size_t len = m_literal.size();
+    bool result;
+
+    switch (m_kind) {
+    case LITERAL:
+        return str.size() == len && memcmp(str.data(), m_literal.data(), len) == 0;
+    case PREFIX:
+        return str.size() >= len && memcmp(str.data(), m_literal.data(), len) == 0;
+    case SUFFIX:
+        return str.size() >= len &&
+            memcmp(str.data() + str.size() - len, m_literal.data(), len) == 0;
+    case INFIX:
+        return str.find(m_literal) != string::npos;
+    case AUTOMATON:
+        if (m_dfa->match(str, result))
+            return result;
+        if (m_regex == 0 && !compilePosix())
+            return false;
+        break;
+    case POSIX:
+        break;
+    }
+
     if (m_regex)
         return regexec(m_regex, str.c_str(), 0, 0, 0) == 0;
     else
@@ -81,10 +515,22 @@ bool RegExp::match(const string &str) const {
 
 bool RegExp::error() const {
 #ifdef USE_REGEXP
-    return m_regex == 0;
+    return m_kind == POSIX && m_regex == 0;
 #else
     return m_str == "";
 #endif // USE_REGEXP
 }
 
+bool RegExp::literal(string &str) const {
+#ifdef USE_REGEXP
+    if (m_kind != LITERAL)
+        return false;
+    str = m_literal;
+    return true;
+#else
+    str = m_str;
+    return true;
+#endif // USE_REGEXP
+}
+
 } // end namespace FbTk
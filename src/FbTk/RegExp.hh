@@ -39,6 +39,15 @@
 
 namespace FbTk {
 
+/**
+ * A regular expression, matched against the full string by default.
+ *
+ * Full matches of literal strings, and of literals with '.*' in front
+ * and/or behind, are matched with plain string compares. Other full match
+ * expressions made of characters, '.', bracket expressions, groups and
+ * the '*', '+' and '?' operators run on a DFA that is built while
+ * matching. Everything else goes to the POSIX regex functions.
+ */
 class RegExp: private NotCopyable {
 public:
     RegExp(const std::string &str, bool full_match = true);
@@ -48,9 +57,32 @@ public:
 
     bool error() const;
 
+    /**
+     * Checks if the expression matches just one string, i.e. it is a full
+     * match without any special characters other than escaped ones.
+     * @param str is set to that string
+     */
+    bool literal(std::string &str) const;
+
 private:
 #ifdef USE_REGEXP
-    regex_t* m_regex;
+    enum Kind {
+        LITERAL,  ///< the string equals m_literal
+        PREFIX,   ///< m_literal.*
+        SUFFIX,   ///< .*m_literal
+        INFIX,    ///< .*m_literal.*
+        AUTOMATON,///< runs on m_dfa
+        POSIX     ///< runs on m_regex
+    };
+    class Dfa;
+
+    bool compilePosix() const;
+
+    Kind m_kind;
+    std::string m_literal;
+    Dfa *m_dfa;
+    std::string m_posix_str;  ///< the expression as given to regcomp()
+    mutable regex_t* m_regex; ///< compiled when first needed for AUTOMATON
 #else // notdef USE_REGEXP
     std::string m_str;
 #endif // USE_REGEXP
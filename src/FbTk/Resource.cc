@@ -25,6 +25,7 @@
 #include "StringUtil.hh"
 
 #include <iostream>
+#include <algorithm>
 #include <cassert>
 
 using std::cerr;
@@ -35,7 +36,6 @@ namespace FbTk {
 
 ResourceManager::ResourceManager(const char *filename, bool lock_db) :
     m_db_lock(0),
-    m_database(0),
     m_filename(filename ? filename : "")
 {
     static bool xrm_initialized = false;
@@ -49,8 +49,6 @@ ResourceManager::ResourceManager(const char *filename, bool lock_db) :
 }
 
 ResourceManager::~ResourceManager() {
-    if (m_database)
-        delete m_database;
 }
 
 
@@ -61,11 +59,8 @@ ResourceManager::~ResourceManager() {
 bool ResourceManager::load(const char *filename) {
     m_filename = StringUtil::expandFilename(filename).c_str();
 
-    // force reload (lock will ensure it exists)
-    if (m_database) {
-        delete m_database;
-        m_database = 0;
-    }
+    // reopen, ResourceDatabase reads the file again if it changed
+    m_database.reset();
 
     lock();
     if (!m_database) {
@@ -73,19 +68,13 @@ bool ResourceManager::load(const char *filename) {
         return false;
     }
 
-    XrmValue value;
-    char *value_type;
-
     //get list and go throu all the resources and load them
     ResourceList::iterator i = m_resourcelist.begin();
     ResourceList::iterator i_end = m_resourcelist.end();
     for (; i != i_end; ++i) {
 
         Resource_base *resource = *i;
-        if (XrmGetResource(**m_database, resource->name().c_str(),
-                           resource->altName().c_str(), &value_type, &value))
-            resource->setFromString(value.addr);
-        else {
+        if (!loadResource(*resource)) {
             _FB_USES_NLS;
             cerr<<_FBTK_CONSOLETEXT(Error, FailedRead, "Failed to read", "Couldn't load a resource (following)")<<": "<<resource->name()<<endl;
             cerr<<_FBTK_CONSOLETEXT(Error, UsingDefault, "Setting default value", "Falling back to default value for resource")<<endl;
@@ -132,54 +121,34 @@ bool ResourceManager::save(const char *filename, const char *mergefilename) {
 
     //check if we want to merge a database
     if (mergefilename) {
-        // force reload of file
-        m_filename = mergefilename;
-        if (m_database)
-            delete m_database;
-        m_database = 0;
-
-        lock();
-
-        if (!m_database) {
-            unlock();
+        // the merge is done by Xrm, so that is where the file is read into
+        XrmDatabaseHelper merge_database(mergefilename);
+        if (merge_database == 0)
             return false;
-        }
 
-        XrmMergeDatabases(*database, &**m_database); // merge databases
-        XrmPutFileDatabase(**m_database, filename); // save database to file
+        XrmMergeDatabases(*database, &*merge_database); // merge databases
+        XrmPutFileDatabase(*merge_database, filename); // save database to file
 
         // don't try to destroy the database (XrmMergeDatabases destroys it)
         *database = 0;
-        unlock();
     } else // save database to file
         XrmPutFileDatabase(*database, filename);
 
+    ResourceDatabase::forget(filename);
     m_filename = filename;
     return true;
 }
 
 Resource_base *ResourceManager::findResource(const string &resname) {
-   // find resource name
-    ResourceList::iterator i = m_resourcelist.begin();
-    ResourceList::iterator i_end = m_resourcelist.end();
-    for (; i != i_end; ++i) {
-        if ((*i)->name() == resname ||
-            (*i)->altName() == resname)
-            return *i;
-    }
-    return 0;
+    std::unordered_map<string, std::vector<Resource_base *> >::iterator it =
+        m_index.find(resname);
+    return it == m_index.end() ? 0 : it->second.front();
 }
 
 const Resource_base *ResourceManager::findResource(const string &resname) const {
-   // find resource name
-    ResourceList::const_iterator i = m_resourcelist.begin();
-    ResourceList::const_iterator i_end = m_resourcelist.end();
-    for (; i != i_end; ++i) {
-        if ((*i)->name() == resname ||
-            (*i)->altName() == resname)
-            return *i;
-    }
-    return 0;
+    std::unordered_map<string, std::vector<Resource_base *> >::const_iterator it =
+        m_index.find(resname);
+    return it == m_index.end() ? 0 : it->second.front();
 }
 
 string ResourceManager::resourceValue(const string &resname) const {
@@ -202,24 +171,44 @@ ResourceManager &ResourceManager::lock() {
     // if the lock was zero, then load the database
     if ((m_db_lock == 1 || !m_database) &&
         m_filename != "") {
-        m_database = new XrmDatabaseHelper(m_filename.c_str());
-
-        // check that the database loaded ok
-        if (m_database && *m_database == 0) {
-            // didn't work
-            delete m_database;
-            m_database = 0;
-        }
+        // null if the file can't be read
+        m_database = ResourceDatabase::open(m_filename);
     }
 
     return *this;
 }
 
 void ResourceManager::unlock() {
-    if (--m_db_lock == 0 && m_database) {
-        delete m_database;
-        m_database = 0;
+    if (--m_db_lock == 0)
+        m_database.reset();
+}
+
+void ResourceManager::index(Resource_base &r) {
+    m_index[r.name()].push_back(&r);
+    if (r.altName() != r.name())
+        m_index[r.altName()].push_back(&r);
+}
+
+void ResourceManager::unindex(Resource_base &r) {
+    const string *keys[] = { &r.name(), &r.altName() };
+    for (int k = 0; k < 2; ++k) {
+        std::unordered_map<string, std::vector<Resource_base *> >::iterator it =
+            m_index.find(*keys[k]);
+        if (it == m_index.end())
+            continue;
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), &r),
+                         it->second.end());
+        if (it->second.empty())
+            m_index.erase(it);
     }
 }
 
+bool ResourceManager::loadResource(Resource_base &r) const {
+    string value;
+    if (!m_database->lookup(r.name(), r.altName(), value))
+        return false;
+    r.setFromString(value.c_str());
+    return true;
+}
+
 } // end namespace FbTk
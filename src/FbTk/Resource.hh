@@ -24,10 +24,13 @@
 
 #include "NotCopyable.hh"
 #include "Accessor.hh"
-#include "XrmDatabaseHelper.hh"
+#include "ResourceDatabase.hh"
 
 #include <string>
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include <iostream>
 #include <exception>
 #include <typeinfo>
@@ -102,6 +105,7 @@ public:
     template <class T>
     void removeResource(Resource<T> &r) {
         m_resourcelist.remove(&r);
+        unindex(r);
     }
 
     /// searches for the resource with the resourcename
@@ -142,10 +146,16 @@ protected:
     int m_db_lock;
 
 private:
+    void index(Resource_base &r);
+    void unindex(Resource_base &r);
+    /// sets the resource from the database, @return false if it isn't there
+    bool loadResource(Resource_base &r) const;
 
     ResourceList m_resourcelist;
+    /// the resources by name and alternative name, in the order they were added
+    std::unordered_map<std::string, std::vector<Resource_base *> > m_index;
 
-    XrmDatabaseHelper *m_database;
+    std::shared_ptr<const ResourceDatabase> m_database;
 
     std::string m_filename;
 };
@@ -196,8 +206,10 @@ private:
 // add the resource and load its value
 template <class T>
 void ResourceManager::addResource(Resource<T> &r) {
-    m_resourcelist.push_back(&r);
-    m_resourcelist.unique();
+    if (m_resourcelist.empty() || m_resourcelist.back() != &r) {
+        m_resourcelist.push_back(&r);
+        index(r);
+    }
 
     // lock ensures that the database is loaded.
     lock();
@@ -207,14 +219,8 @@ void ResourceManager::addResource(Resource<T> &r) {
         return;
     }
 
-    XrmValue value;
-    char *value_type;
-
     // now, load the value for this resource
-    if (XrmGetResource(**m_database, r.name().c_str(),
-                       r.altName().c_str(), &value_type, &value)) {
-        r.setFromString(value.addr);
-    } else {
+    if (!loadResource(r)) {
         std::cerr<<"Failed to read: "<<r.name()<<std::endl;
         std::cerr<<"Setting default value"<<std::endl;
         r.setDefaultValue();
@@ -0,0 +1,531 @@
+// ResourceDatabase.cc for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "ResourceDatabase.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <list>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+using std::string;
+using std::vector;
+
+namespace FbTk {
+
+namespace {
+
+// what identifies a version of a file
+struct FileStamp {
+    string name;
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    time_t mtime;
+
+    bool read(const string &filename) {
+        struct stat st;
+        if (stat(filename.c_str(), &st) != 0)
+            return false;
+        name = filename;
+        dev = st.st_dev;
+        ino = st.st_ino;
+        size = st.st_size;
+        mtime = st.st_mtime;
+        return true;
+    }
+
+    bool operator == (const FileStamp &other) const {
+        return name == other.name && dev == other.dev && ino == other.ino &&
+            size == other.size && mtime == other.mtime;
+    }
+};
+
+struct Cache {
+    string filename;
+    vector<FileStamp> files;
+    std::shared_ptr<const ResourceDatabase> database;
+};
+
+// enough for the init file, the style and its overlay
+const size_t MAX_CACHED = 4;
+// the most recently used first
+std::list<Cache> s_cache;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+bool isOctal(char c) {
+    return c >= '0' && c <= '7';
+}
+
+// like XrmStringToQuarkList(), empty components are left out
+template <typename Component>
+void split(const string &str, vector<Component> &parts) {
+    parts.clear();
+    size_t start = 0;
+    const size_t size = str.size();
+    while (start < size) {
+        size_t end = str.find('.', start);
+        if (end == string::npos)
+            end = size;
+        if (end > start) {
+            Component part = { start, end - start, false };
+            parts.push_back(part);
+        }
+        start = end + 1;
+    }
+}
+
+// FNV-1a, for the hashes of specifiers and their last components
+size_t hashOf(const char *str, size_t length) {
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ static_cast<unsigned char>(str[i])) * 16777619u;
+    return hash;
+}
+
+/*
+  How well an entry matches a resource, by the rules of XrmGetResource(),
+  looking at the levels from left to right: any component beats skipping
+  the level with a '*', a name beats a class beats '?', and a '.' beats a
+  '*'. Each level gets 3 bits of the score, the first level the highest,
+  so comparing scores compares the levels in turn. Levels past the first
+  21 don't fit and are left out of the score.
+*/
+enum {
+    SKIPPED = 0,
+    ANY = 1, CLASS = 3, NAME = 5, // + 1 for a '.' in front
+};
+
+const size_t SCORED_LEVELS = 21;
+
+// an empty slot of the hash by specifier
+const size_t NO_ENTRY = static_cast<size_t>(-1);
+
+// files that include themselves stop here, like they do in Xrm
+const unsigned int MAX_INCLUDE_DEPTH = 100;
+
+} // end of anonymous namespace
+
+std::shared_ptr<const ResourceDatabase> ResourceDatabase::open(const string &filename) {
+
+    for (std::list<Cache>::iterator it = s_cache.begin(); it != s_cache.end(); ++it) {
+        if (it->filename != filename)
+            continue;
+
+        bool unchanged = true;
+        FileStamp stamp;
+        for (size_t i = 0; unchanged && i < it->files.size(); ++i)
+            unchanged = stamp.read(it->files[i].name) && stamp == it->files[i];
+        if (!unchanged) {
+            s_cache.erase(it);
+            break;
+        }
+        s_cache.splice(s_cache.begin(), s_cache, it);
+        return it->database;
+    }
+
+    std::shared_ptr<ResourceDatabase> database(new ResourceDatabase());
+    if (!database->load(filename))
+        return std::shared_ptr<const ResourceDatabase>();
+
+    Cache cache;
+    cache.filename = filename;
+    for (size_t i = 0; i < database->m_files.size(); ++i) {
+        FileStamp stamp;
+        if (stamp.read(database->m_files[i]))
+            cache.files.push_back(stamp);
+    }
+    cache.database = database;
+    s_cache.push_front(cache);
+    if (s_cache.size() > MAX_CACHED)
+        s_cache.pop_back();
+
+    return database;
+}
+
+void ResourceDatabase::forget(const string &filename) {
+    std::list<Cache>::iterator it = s_cache.begin();
+    while (it != s_cache.end()) {
+        if (it->filename == filename)
+            it = s_cache.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool ResourceDatabase::load(const string &filename) {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+        return false;
+
+    string text;
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size > 0) {
+        text.resize(static_cast<size_t>(size));
+        file.read(&text[0], size);
+        text.resize(static_cast<size_t>(file.gcount()));
+    }
+    if (std::find(m_files.begin(), m_files.end(), filename) == m_files.end())
+        m_files.push_back(filename);
+
+    string::size_type slash = filename.rfind('/');
+    parse(text, slash == string::npos ? "." : filename.substr(0, slash));
+    return true;
+}
+
+void ResourceDatabase::parse(const string &text, const string &dir) {
+
+    const size_t size = text.size();
+    size_t pos = 0;
+
+    while (pos < size) {
+        while (pos < size && isSpace(text[pos]))
+            ++pos;
+        if (pos == size)
+            break;
+
+        if (text[pos] == '\n') {
+            ++pos;
+            continue;
+        }
+
+        // comments and directives end with the line
+        if (text[pos] == '!' || text[pos] == '#') {
+            size_t end = text.find('\n', pos);
+            if (end == string::npos)
+                end = size;
+
+            const string line = text.substr(pos, end - pos);
+            pos = end;
+            if (line.compare(0, 8, "#include") != 0)
+                continue;
+
+            size_t first = line.find('"', 8), last = line.rfind('"');
+            if (first == string::npos || last == first)
+                continue;
+            string name = line.substr(first + 1, last - first - 1);
+            if (!name.empty() && name[0] != '/')
+                name = dir + "/" + name;
+            if (m_include_depth < MAX_INCLUDE_DEPTH) {
+                ++m_include_depth;
+                load(name);
+                --m_include_depth;
+            }
+            continue;
+        }
+
+        // resource name, up to the colon
+        const size_t start = pos;
+        while (pos < size && text[pos] != ':' && text[pos] != '\n' && !isSpace(text[pos]))
+            ++pos;
+        const string specifier(text, start, pos - start);
+        while (pos < size && isSpace(text[pos]))
+            ++pos;
+        if (pos == size || text[pos] != ':') {
+            // not a resource line
+            while (pos < size && text[pos] != '\n')
+                ++pos;
+            continue;
+        }
+        ++pos;
+
+        while (pos < size && isSpace(text[pos]))
+            ++pos;
+
+        // the value, with its escape sequences
+        string value;
+        while (pos < size && text[pos] != '\n') {
+            // plain characters are copied a run at a time
+            size_t run = pos;
+            while (run < size && text[run] != '\n' && text[run] != '\\')
+                ++run;
+            value.append(text, pos, run - pos);
+            pos = run;
+            if (pos == size || text[pos] == '\n')
+                break;
+
+            char c = text[pos++];
+            if (pos == size) {
+                value += c;
+                continue;
+            }
+
+            c = text[pos];
+            if (c == '\n') { // continues on the next line
+                ++pos;
+            } else if (c == 'n') {
+                value += '\n';
+                ++pos;
+            } else if (c == '\\') {
+                value += '\\';
+                ++pos;
+            } else if (pos + 2 < size && isOctal(c) &&
+                       isOctal(text[pos + 1]) && isOctal(text[pos + 2])) {
+                value += static_cast<char>(((c - '0') << 6) |
+                                           ((text[pos + 1] - '0') << 3) |
+                                           (text[pos + 2] - '0'));
+                pos += 3;
+            } else { // drops the backslash, so "\ " is a space that isn't skipped
+                value += c;
+                ++pos;
+            }
+        }
+
+        addEntry(specifier, value);
+    }
+}
+
+void ResourceDatabase::addEntry(const string &specifier, string &value) {
+
+    // Xrm never matches entries that end with a binding or a '?'
+    const size_t size = specifier.size();
+    if (size == 0 || specifier[size - 1] == '.' || specifier[size - 1] == '*' ||
+        (specifier[size - 1] == '?' && (size == 1 || specifier[size - 2] == '.' ||
+                                        specifier[size - 2] == '*')))
+        return;
+
+    Entry entry;
+    entry.exact = true;
+    entry.value.swap(value);
+
+    // most entries are full names already
+    if (specifier[0] != '.' && specifier.find_first_of("*?") == string::npos &&
+        specifier.find("..") == string::npos) {
+        entry.specifier = specifier;
+        insert(entry);
+        return;
+    }
+
+    entry.specifier.reserve(size);
+    bool loose = false, binding = false;
+    for (size_t i = 0; i < size; ++i) {
+        const char c = specifier[i];
+        if (c == '.' || c == '*') {
+            loose = loose || c == '*';
+            binding = true;
+            continue;
+        }
+        if (binding || (i == 0 && loose)) {
+            if (loose || !entry.specifier.empty())
+                entry.specifier += loose ? '*' : '.';
+            entry.exact = entry.exact && !loose;
+            loose = binding = false;
+        }
+        if (c == '?' && (i + 1 == size || specifier[i + 1] == '.' || specifier[i + 1] == '*') &&
+            (i == 0 || specifier[i - 1] == '.' || specifier[i - 1] == '*'))
+            entry.exact = false;
+        entry.specifier += c;
+    }
+    insert(entry);
+}
+
+void ResourceDatabase::merge(const ResourceDatabase &other) {
+    for (size_t i = 0; i < other.m_entries.size(); ++i) {
+        Entry entry = other.m_entries[i];
+        insert(entry);
+    }
+}
+
+void ResourceDatabase::insert(Entry &entry) {
+    // at most half full, so probing stays short
+    if (2 * (m_entries.size() + 1) > m_slots.size()) {
+        vector<std::pair<size_t, size_t> > slots(std::max(m_slots.size() * 2, size_t(64)),
+                                                 std::make_pair(size_t(0), NO_ENTRY));
+        m_slots.swap(slots);
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].second == NO_ENTRY)
+                continue;
+            size_t slot = slots[i].first & mask;
+            while (m_slots[slot].second != NO_ENTRY)
+                slot = (slot + 1) & mask;
+            m_slots[slot] = slots[i];
+        }
+    }
+
+    // a later entry replaces the value of the same specifier
+    const size_t hash = hashOf(entry.specifier.data(), entry.specifier.size());
+    const size_t slot = findSlot(entry.specifier, hash);
+    if (m_slots[slot].second != NO_ENTRY) {
+        m_entries[m_slots[slot].second].value.swap(entry.value);
+        return;
+    }
+
+    m_slots[slot] = std::make_pair(hash, m_entries.size());
+    m_entries.push_back(Entry());
+    Entry &added = m_entries.back();
+    added.specifier.swap(entry.specifier);
+    added.value.swap(entry.value);
+    added.exact = entry.exact;
+    m_indexed = false;
+}
+
+size_t ResourceDatabase::findSlot(const string &specifier, size_t hash) const {
+    const size_t mask = m_slots.size() - 1;
+    size_t slot = hash & mask;
+    while (m_slots[slot].second != NO_ENTRY &&
+           (m_slots[slot].first != hash || m_entries[m_slots[slot].second].specifier != specifier))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+void ResourceDatabase::buildIndex() const {
+    m_components.clear();
+    m_first_component.clear();
+    m_by_last.clear();
+    m_first_component.reserve(m_entries.size() + 1);
+    m_by_last.reserve(m_entries.size());
+
+    for (size_t e = 0; e < m_entries.size(); ++e) {
+        const string &specifier = m_entries[e].specifier;
+        m_first_component.push_back(m_components.size());
+        size_t start = 0;
+        bool loose = false;
+        if (specifier[0] == '*') {
+            loose = true;
+            start = 1;
+        }
+        while (true) {
+            size_t end = specifier.find_first_of(".*", start);
+            if (end == string::npos)
+                end = specifier.size();
+            Component component = { start, end - start, loose };
+            m_components.push_back(component);
+            if (end == specifier.size())
+                break;
+            loose = specifier[end] == '*';
+            start = end + 1;
+        }
+        const Component &last = m_components.back();
+        m_by_last.push_back(std::make_pair(hashOf(specifier.data() + last.start, last.length), e));
+    }
+    m_first_component.push_back(m_components.size());
+    std::sort(m_by_last.begin(), m_by_last.end());
+    m_indexed = true;
+}
+
+bool ResourceDatabase::bestMatch(const string &specifier, size_t component, size_t end,
+                                 const string &name, const string &classname,
+                                 size_t level, unsigned long long &score) const {
+
+    if (component == end)
+        return level == m_names.size();
+    if (level == m_names.size())
+        return false;
+
+    const Component &c = m_components[component];
+    const Component &n = m_names[level];
+    const char *str = specifier.data() + c.start;
+    const unsigned int shift = level < SCORED_LEVELS ?
+        3 * (std::min(m_names.size(), SCORED_LEVELS) - 1 - level) : 0;
+
+    int kind = -1;
+    if (c.length == n.length && memcmp(str, name.data() + n.start, c.length) == 0)
+        kind = NAME;
+    else if (level < m_classes.size() && c.length == m_classes[level].length &&
+             memcmp(str, classname.data() + m_classes[level].start, c.length) == 0)
+        kind = CLASS;
+    else if (c.length == 1 && *str == '?')
+        kind = ANY;
+
+    bool found = false;
+    unsigned long long rest = 0;
+    if (kind >= 0 && bestMatch(specifier, component + 1, end, name, classname, level + 1, rest)) {
+        if (level < SCORED_LEVELS)
+            rest |= static_cast<unsigned long long>(kind + (c.loose ? 0 : 1)) << shift;
+        score = rest;
+        found = true;
+    }
+
+    // skipped levels score 0
+    if (c.loose && bestMatch(specifier, component, end, name, classname, level + 1, rest) &&
+        (!found || rest > score)) {
+        score = rest;
+        found = true;
+    }
+
+    return found;
+}
+
+bool ResourceDatabase::lookup(const string &name, const string &classname,
+                              string &value) const {
+
+    // nothing beats a full name
+    if (m_entries.empty())
+        return false;
+    const size_t exact = m_slots[findSlot(name, hashOf(name.data(), name.size()))].second;
+    if (exact != NO_ENTRY && m_entries[exact].exact) {
+        value = m_entries[exact].value;
+        return true;
+    }
+
+    if (!m_indexed)
+        buildIndex();
+
+    split(name, m_names);
+    split(classname, m_classes);
+    if (m_names.empty())
+        return false;
+
+    // the entries can only end with the last name, the last class or '?'
+    size_t last[3];
+    int num_last = 0;
+    const Component &last_name = m_names.back();
+    last[num_last++] = hashOf(name.data() + last_name.start, last_name.length);
+    if (m_classes.size() == m_names.size()) {
+        const Component &last_class = m_classes.back();
+        const size_t hash = hashOf(classname.data() + last_class.start, last_class.length);
+        if (hash != last[0])
+            last[num_last++] = hash;
+    }
+    last[num_last++] = hashOf("?", 1);
+
+    size_t best = m_entries.size();
+    unsigned long long best_score = 0, score;
+    for (int l = 0; l < num_last; ++l) {
+        vector<std::pair<size_t, size_t> >::const_iterator it =
+            std::lower_bound(m_by_last.begin(), m_by_last.end(), std::make_pair(last[l], size_t(0)));
+        for (; it != m_by_last.end() && it->first == last[l]; ++it) {
+            const size_t e = it->second;
+            if (bestMatch(m_entries[e].specifier, m_first_component[e], m_first_component[e + 1],
+                          name, classname, 0, score) &&
+                (best == m_entries.size() || score > best_score)) {
+                best = e;
+                best_score = score;
+            }
+        }
+    }
+
+    if (best == m_entries.size())
+        return false;
+    value = m_entries[best].value;
+    return true;
+}
+
+} // end namespace FbTk
@@ -0,0 +1,118 @@
+// ResourceDatabase.hh for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FBTK_RESOURCEDATABASE_HH
+#define FBTK_RESOURCEDATABASE_HH
+
+#include "NotCopyable.hh"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace FbTk {
+
+/**
+ * A resource file, read the way XrmGetFileDatabase() reads it and looked
+ * up with the precedence rules of XrmGetResource().
+ *
+ * Entries that spell out a full resource name are found with one hash
+ * lookup. For everything else, the entries are indexed by their last
+ * component the first time it's needed, so a lookup only checks the
+ * entries that can end with the last level of the name.
+ */
+class ResourceDatabase: private NotCopyable {
+public:
+    ResourceDatabase(): m_indexed(false), m_include_depth(0) { }
+
+    /**
+     * Reads a file, or takes it from an earlier call while neither it nor
+     * the files it includes changed. The last few files are kept.
+     * @return 0 if the file can't be read
+     */
+    static std::shared_ptr<const ResourceDatabase> open(const std::string &filename);
+    /// the next open() of the file reads it again
+    static void forget(const std::string &filename);
+
+    /// adds the entries of a file, @return false if it can't be read
+    bool load(const std::string &filename);
+    /// adds the entries of a resource file held in a string
+    void parse(const std::string &text, const std::string &dir = ".");
+    /// adds the entries of another database, like XrmMergeDatabases()
+    void merge(const ResourceDatabase &other);
+
+    /**
+     * @param name is the full name, like session.screen0.toolbar.visible
+     * @param classname is the full class, like Session.Screen0.Toolbar.Visible
+     * @return false if no entry matches
+     */
+    bool lookup(const std::string &name, const std::string &classname,
+                std::string &value) const;
+
+    bool empty() const { return m_entries.empty(); }
+
+private:
+    struct Entry {
+        std::string specifier; ///< with every run of bindings as one '.' or '*'
+        std::string value;
+        bool exact;            ///< just names with tight bindings
+    };
+    /// where a component sits in a specifier or a resource name
+    struct Component {
+        size_t start, length;
+        bool loose;                  ///< binding before the component is a '*'
+    };
+
+    /// adds a line of a resource file, taking the value
+    void addEntry(const std::string &specifier, std::string &value);
+    /// adds @a entry, taking its strings
+    void insert(Entry &entry);
+    /// @return the slot of the specifier, or the empty slot it would go to
+    size_t findSlot(const std::string &specifier, size_t hash) const;
+    void buildIndex() const;
+    bool bestMatch(const std::string &specifier, size_t component, size_t end,
+                   const std::string &name, const std::string &classname,
+                   size_t level, unsigned long long &score) const;
+
+    std::vector<Entry> m_entries;
+    /// (hash of the specifier, entry), linearly probed
+    std::vector<std::pair<size_t, size_t> > m_slots;
+
+    mutable bool m_indexed;
+    /// the components of all entries, one entry after the other
+    mutable std::vector<Component> m_components;
+    /// where the components of each entry start, and where the last one ends
+    mutable std::vector<size_t> m_first_component;
+    /// (hash of the last component, entry), sorted
+    mutable std::vector<std::pair<size_t, size_t> > m_by_last;
+    /// the levels of the name and class being looked up
+    mutable std::vector<Component> m_names, m_classes;
+
+    /// the files that were read, for open()
+    std::vector<std::string> m_files;
+    /// how many #includes deep the file being read is
+    unsigned int m_include_depth;
+};
+
+} // end namespace FbTk
+
+#endif // FBTK_RESOURCEDATABASE_HH
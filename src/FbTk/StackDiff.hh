@@ -0,0 +1,109 @@
+// StackDiff.hh for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FBTK_STACKDIFF_HH
+#define FBTK_STACKDIFF_HH
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace FbTk {
+
+/// put 'window' directly above or below 'sibling'
+template <typename T>
+struct StackMove {
+    T window;
+    T sibling;
+    bool above;
+};
+
+/**
+ * Computes the moves that turn the stacking order @a from into @a to (both
+ * listed top first). The longest run of windows that already are in the
+ * right relative order stays where it is, everything else is moved next to
+ * a neighbour that is already in place. Windows that only appear in @a from
+ * are ignored; windows new in @a to get moved into place.
+ */
+template <typename T>
+void diffStack(const std::vector<T> &from, const std::vector<T> &to,
+               std::vector<StackMove<T> > &moves) {
+
+    moves.clear();
+    if (to.empty())
+        return;
+
+    std::map<T, size_t> old_pos;
+    for (size_t i = 0; i < from.size(); ++i)
+        old_pos[from[i]] = i;
+
+    // longest increasing run of old positions, by patience sorting:
+    // tails[k] is the entry of 'to' ending the best run of length k + 1
+    const size_t NONE = to.size();
+    std::vector<size_t> pos(to.size(), NONE), tails, prev(to.size(), NONE);
+    for (size_t i = 0; i < to.size(); ++i) {
+        typename std::map<T, size_t>::const_iterator it = old_pos.find(to[i]);
+        if (it == old_pos.end())
+            continue;
+        pos[i] = it->second;
+
+        size_t lo = 0, hi = tails.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (pos[tails[mid]] < pos[i])
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo > 0)
+            prev[i] = tails[lo - 1];
+        if (lo == tails.size())
+            tails.push_back(i);
+        else
+            tails[lo] = i;
+    }
+
+    std::vector<bool> keep(to.size(), false);
+    if (tails.empty())
+        keep[0] = true; // nothing to keep, the top window anchors the rest
+    for (size_t i = tails.empty() ? NONE : tails.back(); i != NONE; i = prev[i])
+        keep[i] = true;
+
+    const size_t first = std::find(keep.begin(), keep.end(), true) - keep.begin();
+
+    // stack the windows above the first kept one upwards from it ...
+    for (size_t i = first; i > 0; --i) {
+        StackMove<T> move = { to[i - 1], to[i], true };
+        moves.push_back(move);
+    }
+
+    // ... and the others below the window that precedes them
+    for (size_t i = first + 1; i < to.size(); ++i) {
+        if (keep[i])
+            continue;
+        StackMove<T> move = { to[i], to[i - 1], false };
+        moves.push_back(move);
+    }
+}
+
+} // end namespace FbTk
+
+#endif // FBTK_STACKDIFF_HH
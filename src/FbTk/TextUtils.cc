@@ -25,6 +25,10 @@
 #include "Theme.hh"
 
 #include <cstring>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 namespace {
 
@@ -34,6 +38,9 @@ namespace {
 void maxTextLength(int n_pixels, const FbTk::Font& font, const char* const text,
         unsigned int& text_len, int& text_width) {
 
+    if (font.fitText(text, text_len, n_pixels, text_width))
+        return;
+
     text_width = font.textWidth(text, text_len);
 
     // rendered text exceeds n_pixels. calculate 'len' to cut off 'text'.
@@ -75,6 +82,98 @@ void maxTextLength(int n_pixels, const FbTk::Font& font, const char* const text,
     }
 }
 
+/**
+ * The last measurements of maxTextLength(), as the same titles are fit
+ * into the same few widths by the iconbar, the frame, the tabs and the
+ * menus over and over.
+ */
+class LayoutCache {
+public:
+    LayoutCache(): m_hits(0), m_misses(0) { }
+
+    void maxTextLength(int n_pixels, const FbTk::Font &font, const char * const text,
+                       unsigned int &text_len, int &text_width) {
+        Layout layout;
+        layout.font = &font;
+        layout.text.assign(text, text_len);
+        layout.n_pixels = n_pixels;
+
+        Index::iterator it = m_index.find(layout);
+        if (it != m_index.end()) {
+            ++m_hits;
+            m_layouts.splice(m_layouts.begin(), m_layouts, it->second);
+            text_len = it->second->text_len;
+            text_width = it->second->text_width;
+            return;
+        }
+
+        ++m_misses;
+        ::maxTextLength(n_pixels, font, text, text_len, text_width);
+        layout.text_len = text_len;
+        layout.text_width = text_width;
+
+        if (m_layouts.size() >= CAPACITY) {
+            m_index.erase(m_layouts.back());
+            m_layouts.pop_back();
+        }
+        m_layouts.push_front(layout);
+        m_index[m_layouts.front()] = m_layouts.begin();
+    }
+
+    void forget(const FbTk::Font &font) {
+        std::list<Layout>::iterator it = m_layouts.begin();
+        while (it != m_layouts.end()) {
+            if (it->font == &font) {
+                m_index.erase(*it);
+                it = m_layouts.erase(it);
+            } else
+                ++it;
+        }
+    }
+
+    FbTk::TextLayoutStats stats() const {
+        FbTk::TextLayoutStats stats = { m_hits, m_misses, m_layouts.size(), CAPACITY };
+        return stats;
+    }
+
+private:
+    // a few hundred windows' worth of titles in a few places
+    static const size_t CAPACITY = 1024;
+
+    struct Layout {
+        // what is measured
+        const FbTk::Font *font;
+        std::string text;
+        int n_pixels;
+        // what fits
+        unsigned int text_len;
+        int text_width;
+    };
+    struct SameLayout {
+        bool operator()(const Layout &a, const Layout &b) const {
+            return a.font == b.font && a.n_pixels == b.n_pixels && a.text == b.text;
+        }
+    };
+    struct HashLayout {
+        size_t operator()(const Layout &layout) const {
+            return std::hash<std::string>()(layout.text) ^
+                (std::hash<const void *>()(layout.font) * 31 + layout.n_pixels);
+        }
+    };
+    typedef std::unordered_map<Layout, std::list<Layout>::iterator,
+                               HashLayout, SameLayout> Index;
+
+    std::list<Layout> m_layouts; ///< the most recently used first
+    Index m_index;
+    unsigned long m_hits, m_misses;
+};
+
+// never destroyed, fonts may go after it
+LayoutCache &layouts() {
+    static LayoutCache *cache = new LayoutCache();
+    return *cache;
+}
+
 }
 
 namespace FbTk {
@@ -88,7 +187,7 @@ int doAlignment(int n_pixels, int bevel, FbTk::Justify justify,
 
     int text_width;
 
-    maxTextLength(n_pixels - bevel, font, text, textlen, text_width);
+    layouts().maxTextLength(n_pixels - bevel, font, text, textlen, text_width);
 
     newlen = textlen;
 
@@ -101,6 +200,14 @@ int doAlignment(int n_pixels, int bevel, FbTk::Justify justify,
     return bevel;
 }
 
+TextLayoutStats textLayoutStats() {
+    return layouts().stats();
+}
+
+void forgetTextLayouts(const FbTk::Font &font) {
+    layouts().forget(font);
+}
+
 
 /// specialization for Justify
 template <>
@@ -24,6 +24,8 @@
 
 #include "Orientation.hh"
 
+#include <cstddef>
+
 namespace FbTk {
 
 class Font;
@@ -35,6 +37,19 @@ int doAlignment(int max_pixels, int bevel, FbTk::Justify justify,
                 const FbTk::Font &font, const char * const text, 
                 unsigned int textlen, unsigned int &newlen);
 
+/// how well doAlignment() reuses its measurements
+struct TextLayoutStats {
+    unsigned long hits;
+    unsigned long misses;
+    size_t size;
+    size_t capacity;
+};
+
+TextLayoutStats textLayoutStats();
+
+/// forgets the measurements made with the font, for when it changes
+void forgetTextLayouts(const FbTk::Font &font);
+
 /**
    There are 3 interesting translations:
    1) Coords = simple rotation of coordinates
@@ -21,7 +21,6 @@
 
 #include "Theme.hh"
 
-#include "XrmDatabaseHelper.hh"
 #include "App.hh"
 #include "StringUtil.hh"
 #include "FileUtil.hh"
@@ -52,18 +51,23 @@ struct LoadThemeHelper {
     void operator ()(ThemeManager::ThemeList &tmlist) {
 
         STLUtil::forAll(tmlist, *this);
-        // send reconfiguration signal to theme and listeners
+        // send reconfiguration signal to the themes that changed and
+        // their listeners
         ThemeManager::ThemeList::iterator it = tmlist.begin();
         ThemeManager::ThemeList::iterator it_end = tmlist.end();
         for (; it != it_end; ++it) {
-            (*it)->reconfigSig().emit();
+            if ((*it)->changed()) {
+                (*it)->m_changed = false;
+                (*it)->reconfigSig().emit();
+            }
         }
     }
 
     ThemeManager &m_tm;
 };
 
-Theme::Theme(int screen_num):m_screen_num(screen_num) {
+Theme::Theme(int screen_num):m_screen_num(screen_num), m_all_changed(true),
+                             m_change_count(0), m_changed(true) {
     ThemeManager::instance().registerTheme(*this);
 }
 
@@ -71,6 +75,15 @@ Theme::~Theme() {
     ThemeManager::instance().unregisterTheme(*this);
 }
 
+bool Theme::onlyChanged(const ThemeItem_base *const items[], size_t count) const {
+    if (m_all_changed)
+        return false;
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i)
+        found += m_changed_items.count(items[i]);
+    return found == m_changed_items.size();
+}
+
 ThemeManager &ThemeManager::instance() {
     static ThemeManager tm;
     return tm;
@@ -80,8 +93,10 @@ ThemeManager::ThemeManager():
     // max_screens: we initialize this later so we can set m_verbose
     // without having a display connection
     m_max_screens(-1),
+    m_loading(0),
     m_verbose(false),
-    m_themelocation("") {
+    m_themelocation(""),
+    m_location(1) {
 
 }
 
@@ -138,23 +153,35 @@ bool ThemeManager::load(const string &filename,
         prefix = location.substr(0, location.find_last_of('/'));
     }
 
-    if (!m_database.load(location.c_str()))
+    // the files are only parsed again when they changed
+    std::shared_ptr<const ResourceDatabase> style = ResourceDatabase::open(location);
+    if (style == 0)
         return false;
 
-
+    std::shared_ptr<const ResourceDatabase> overlay;
     if (!overlay_filename.empty()) {
         string overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
-        if (FileUtil::isRegularFile(overlay_location.c_str())) {
-            XrmDatabaseHelper overlay_db;
-            if (overlay_db.load(overlay_location.c_str())) {
-                // after a merge the src_db is destroyed
-                // so, make sure XrmDatabaseHelper::m_database == 0
-                XrmMergeDatabases(*overlay_db, &(*m_database));
-                *overlay_db = 0;
-            }
+        if (FileUtil::isRegularFile(overlay_location.c_str()))
+            overlay = ResourceDatabase::open(overlay_location);
+    }
+
+    if (style != m_style || overlay != m_overlay || m_database == 0) {
+        m_style = style;
+        m_overlay = overlay;
+        if (overlay == 0)
+            m_database = style;
+        else {
+            std::shared_ptr<ResourceDatabase> merged(new ResourceDatabase());
+            merged->merge(*style);
+            merged->merge(*overlay);
+            m_database = merged;
         }
+        m_resolved.clear();
     }
 
+    if (prefix != m_themelocation)
+        ++m_location;
+
     // relies on the fact that load_rc clears search paths each time
     if (m_themelocation != "") {
         Image::removeSearchPath(m_themelocation);
@@ -183,13 +210,37 @@ bool ThemeManager::load(const string &filename,
 }
 
 void ThemeManager::loadTheme(Theme &tm) {
+    // a pending setChanged() changes everything
+    const bool all_changed = tm.m_changed;
+    std::set<const ThemeItem_base *> changed_items;
+
     Theme::ItemList::iterator i = tm.itemList().begin();
     Theme::ItemList::iterator i_end = tm.itemList().end();
     for (; i != i_end; ++i) {
         ThemeItem_base *resource = *i;
+        // style switches and reconfigures only load the items that change
+        if (unchanged(*resource))
+            continue;
+
+        changed_items.insert(resource);
+        tm.m_changed = true;
+
+        resource->m_lookups.clear();
+        resource->m_location = m_location;
+        m_loading = resource;
+
         if (!loadItem(*resource)) {
             // try fallback resource in theme
-            if (!tm.fallback(*resource)) {
+            const size_t looked_up = resource->m_lookups.size();
+            if (tm.fallback(*resource)) {
+                // a value that didn't come from the style can't be told
+                // unchanged, unless the fallback said where it came from
+                bool found = false;
+                for (size_t l = looked_up; !found && l < resource->m_lookups.size(); ++l)
+                    found = resource->m_lookups[l].found;
+                if (!found)
+                    resource->m_lookups.clear();
+            } else {
                 if (verbose()) {
                     _FB_USES_NLS;
                     cerr<<_FBTK_CONSOLETEXT(Error, ThemeItem, "Failed to read theme item", "When reading a style, couldn't read a specific item (following)")<<": "<<resource->name()<<endl;
@@ -197,6 +248,15 @@ void ThemeManager::loadTheme(Theme &tm) {
                 resource->setDefaultValue();
             }
         }
+
+        m_loading = 0;
+    }
+
+    // listeners ask what the last load that changed something changed
+    if (tm.m_changed) {
+        tm.m_changed_items.swap(changed_items);
+        tm.m_all_changed = all_changed;
+        ++tm.m_change_count;
     }
     // send reconfiguration signal to theme and listeners
 }
@@ -207,11 +267,9 @@ bool ThemeManager::loadItem(ThemeItem_base &resource) {
 
 /// handles resource item loading with specific name/altname
 bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const string &alt_name) {
-    XrmValue value;
-    char *value_type;
-    if (XrmGetResource(*m_database, name.c_str(),
-                       alt_name.c_str(), &value_type, &value)) {
-        resource.setFromString(value.addr);
+    string value;
+    if (lookup(name, alt_name, value)) {
+        resource.setFromString(value.c_str());
         resource.load(&name, &alt_name); // load additional stuff by the ThemeItem
     } else
         return false;
@@ -219,16 +277,57 @@ bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const
     return true;
 }
 
+void ThemeManager::loadedFrom(const ThemeItem_base &source) {
+    if (m_loading != 0 && m_loading != &source)
+        m_loading->m_lookups.insert(m_loading->m_lookups.end(),
+                                    source.m_lookups.begin(), source.m_lookups.end());
+}
+
 string ThemeManager::resourceValue(const string &name, const string &altname) {
-    XrmValue value;
-    char *value_type;
-    if (*m_database != 0 && XrmGetResource(*m_database, name.c_str(),
-                                           altname.c_str(), &value_type, &value) && value.addr != 0)
-        return string(value.addr);
+    string value;
+    if (lookup(name, altname, value))
+        return value;
 
     return "";
 }
 
+bool ThemeManager::lookup(const string &name, const string &altname, string &value) {
+
+    // the screens have the same items, so most lookups are repeated
+    const string key = name + '\n' + altname;
+    std::unordered_map<string, std::pair<bool, string> >::iterator it = m_resolved.find(key);
+    if (it == m_resolved.end()) {
+        std::pair<bool, string> resolved(false, "");
+        if (m_database != 0)
+            resolved.first = m_database->lookup(name, altname, resolved.second);
+        it = m_resolved.insert(std::make_pair(key, resolved)).first;
+    }
+
+    if (m_loading != 0) {
+        ThemeItem_base::Lookup used = { name, altname, it->second.second, it->second.first };
+        m_loading->m_lookups.push_back(used);
+    }
+
+    value = it->second.second;
+    return it->second.first;
+}
+
+bool ThemeManager::unchanged(const ThemeItem_base &item) {
+    if (item.m_location != m_location || item.m_lookups.empty())
+        return false;
+
+    string value;
+    for (size_t i = 0; i < item.m_lookups.size(); ++i) {
+        const ThemeItem_base::Lookup &used = item.m_lookups[i];
+        // an item that isn't kept as loaded can only be kept at its default
+        if (!item.m_keeps_value && used.found)
+            return false;
+        if (lookup(used.name, used.altname, value) != used.found || value != used.value)
+            return false;
+    }
+    return true;
+}
+
 /*
 void ThemeManager::listItems() {
     ThemeList::iterator it = m_themelist.begin();
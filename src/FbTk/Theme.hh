@@ -27,15 +27,28 @@
 #define FBTK_THEME_HH
 
 #include "Signal.hh"
-#include "XrmDatabaseHelper.hh"
+#include "ResourceDatabase.hh"
 
 #include <string>
 #include <list>
+#include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace FbTk {
 
 class Theme;
+class PixmapWithMask;
+struct LoadThemeHelper;
+
+/// if the value of a ThemeItem<T> stays the way it was loaded, so it
+/// doesn't have to be loaded again from the same resources
+template <typename T>
+struct ThemeItemKeepsValue { static const bool value = true; };
+/// the themes scale pixmaps to fit after loading them
+template <>
+struct ThemeItemKeepsValue<PixmapWithMask> { static const bool value = false; };
 
 /// Base class for ThemeItem, holds name and altname
 /**
@@ -43,8 +56,10 @@ class Theme;
 */
 class ThemeItem_base {
 public:
-    ThemeItem_base(const std::string &name, const std::string &altname):
-        m_name(name), m_altname(altname) { }
+    ThemeItem_base(const std::string &name, const std::string &altname,
+                   bool keeps_value = true):
+        m_name(name), m_altname(altname),
+        m_keeps_value(keeps_value), m_location(0) { }
     virtual ~ThemeItem_base() { }
     virtual void setFromString(const char *str) = 0;
     virtual void setDefaultValue() = 0;
@@ -52,7 +67,19 @@ public:
     const std::string &name() const { return m_name; }
     const std::string &altName() const { return m_altname; }
 private:
+    friend class ThemeManager;
+
+    /// a resource looked up while loading the item
+    struct Lookup {
+        std::string name, altname, value;
+        bool found;
+    };
+
     std::string m_name, m_altname;
+    bool m_keeps_value;
+    /// what the last load looked up, and in which style directory
+    std::vector<Lookup> m_lookups;
+    unsigned int m_location;
 };
 
 
@@ -107,13 +134,39 @@ public:
     template <typename T>
     void remove(ThemeItem<T> &item);
     virtual bool fallback(ThemeItem_base &) { return false; }
+    /// emitted after a load that changed something
     Signal<> &reconfigSig() { return m_reconfig_sig; }
 
+    /// @return true if the last load that changed the theme changed the item
+    bool changed(const ThemeItem_base &item) const {
+        return m_all_changed || m_changed_items.find(&item) != m_changed_items.end();
+    }
+    /// @return how many loads changed the theme, to tell if changed() is news
+    unsigned int changeCount() const { return m_change_count; }
+    /// @return true if the next reconfigSig() is due
+    bool changed() const { return m_changed; }
+    /**
+     * For settings that aren't ThemeItems, the next load tells the listeners.
+     * All items count as changed then.
+     */
+    void setChanged() { m_changed = true; }
+
+protected:
+    /// @return true if the last load that changed the theme changed no other items
+    bool onlyChanged(const ThemeItem_base *const items[], size_t count) const;
+
 private:
+    friend class ThemeManager;
+    friend struct LoadThemeHelper;
+
     const int m_screen_num;
 
     ItemList m_themeitems;
     Signal<> m_reconfig_sig;
+    std::set<const ThemeItem_base *> m_changed_items;
+    bool m_all_changed;
+    unsigned int m_change_count;
+    bool m_changed;
 };
 
 /// Proxy interface for themes, so they can be substituted dynamically
@@ -146,6 +199,9 @@ public:
     void loadTheme(Theme &tm);
     bool loadItem(ThemeItem_base &resource);
     bool loadItem(ThemeItem_base &resource, const std::string &name, const std::string &altname);
+    /// for a fallback that copies the value of @a source into the item being
+    /// loaded, so the item is loaded again whenever @a source would be
+    void loadedFrom(const ThemeItem_base &source);
 
     bool verbose() const { return m_verbose; }
     void setVerbose(bool value) { m_verbose = value; }
@@ -163,14 +219,25 @@ private:
     bool registerTheme(FbTk::Theme &tm);
     /// @return false if theme isn't registred in the manager
     bool unregisterTheme(FbTk::Theme &tm);
-    /// map each theme manager to a screen
+    /// looks up a resource, and records it for the item being loaded
+    bool lookup(const std::string &name, const std::string &altname, std::string &value);
+    /// @return true if the item would load the same as last time
+    bool unchanged(const ThemeItem_base &item);
 
+    /// map each theme manager to a screen
     ScreenThemeVector m_themes;
     int m_max_screens;
-    XrmDatabaseHelper m_database;
+    std::shared_ptr<const ResourceDatabase> m_style, m_overlay; ///< as read from the files
+    std::shared_ptr<const ResourceDatabase> m_database; ///< the style with the overlay
+    /// the lookups of m_database so far, by name and altname
+    std::unordered_map<std::string, std::pair<bool, std::string> > m_resolved;
+    /// the item being loaded
+    ThemeItem_base *m_loading;
     bool m_verbose;
 
     std::string m_themelocation;
+    /// changes with the style directory, which pixmaps are searched in
+    unsigned int m_location;
 };
 
 
@@ -178,7 +245,7 @@ private:
 template <typename T>
 ThemeItem<T>::ThemeItem(FbTk::Theme &tm,
                         const std::string &name, const std::string &altname):
-    ThemeItem_base(name, altname),
+    ThemeItem_base(name, altname, ThemeItemKeepsValue<T>::value),
     m_tm(tm) {
     tm.add(*this);
     setDefaultValue();
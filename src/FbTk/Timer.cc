@@ -46,7 +46,9 @@
 #  include <winsock.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
+#include <map>
 #include <vector>
 #include <set>
 
@@ -64,6 +66,9 @@ struct TimerCompare {
 typedef std::set<FbTk::Timer*, TimerCompare> TimerList;
 TimerList s_timerlist;
 
+typedef std::map<int, FbTk::RefCount<FbTk::Slot<void> > > WatchedFds;
+WatchedFds s_watched_fds;
+
 }
 
 
@@ -160,6 +165,12 @@ void Timer::updateTimers(int fd) {
 
     FD_ZERO(&rfds);
     FD_SET(fd, &rfds);
+    int max_fd = fd;
+    WatchedFds::const_iterator w = s_watched_fds.begin();
+    for (; w != s_watched_fds.end(); ++w) {
+        FD_SET(w->first, &rfds);
+        max_fd = std::max(max_fd, w->first);
+    }
     tout = NULL;
 
     // search for overdue timers
@@ -182,8 +193,20 @@ void Timer::updateTimers(int fd) {
     // if not overdue, wait for the next xevent via the blocking
     // select(), so OS sends fluxbox to sleep. the select() will
     // time out when the next timer has to be handled
-    if (!overdue && select(fd + 1, &rfds, 0, 0, tout) != 0) {
-        // didn't time out! x events are pending
+    int ready = 0;
+    if (!overdue && (ready = select(max_fd + 1, &rfds, 0, 0, tout)) != 0) {
+        // didn't time out! x events are pending, or one of the watched
+        // descriptors can be read
+        if (ready > 0 && !s_watched_fds.empty()) {
+            // the handlers may (un)watch
+            std::vector<RefCount<Slot<void> > > handlers;
+            for (w = s_watched_fds.begin(); w != s_watched_fds.end(); ++w) {
+                if (FD_ISSET(w->first, &rfds))
+                    handlers.push_back(w->second);
+            }
+            for (size_t i = 0; i < handlers.size(); ++i)
+                (*handlers[i])();
+        }
         return;
     }
 
@@ -225,6 +248,15 @@ void Timer::updateTimers(int fd) {
 }
 
 
+void Timer::watchFd(int fd, const RefCount<Slot<void> > &handler) {
+    s_watched_fds[fd] = handler;
+}
+
+void Timer::unwatchFd(int fd) {
+    s_watched_fds.erase(fd);
+}
+
+
 Command<void> *DelayedCmd::parse(const std::string &command,
                            const std::string &args, bool trusted) {
 
@@ -56,6 +56,9 @@ public:
     void stop();
 
     static void updateTimers(int file_descriptor);
+    /// updateTimers() also wakes up when fd can be read, and runs handler
+    static void watchFd(int fd, const RefCount<Slot<void> > &handler);
+    static void unwatchFd(int fd);
 
     int isTiming() const;
     int getInterval() const { return m_interval; }
@@ -23,12 +23,113 @@
 #include "App.hh"
 #include "FbDrawable.hh"
 
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <algorithm>
+#include <map>
 
 namespace FbTk {
 
+namespace {
+
+// text is drawn a lot, so nothing on the way should wait for the server
+
+struct CachedColor {
+    Visual *visual;
+    XftColor color;
+};
+typedef std::map<std::pair<unsigned long, Colormap>, CachedColor> XftColors;
+/// the colors text was drawn in, by pixel and colormap
+XftColors s_colors;
+// a handful of styles' worth
+const size_t MAX_COLORS = 64;
+
+/// @return the share of the pixel in mask, scaled to 16 bits
+unsigned short channel(unsigned long pixel, unsigned long mask) {
+    if (mask == 0)
+        return 0;
+    int shift = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++shift;
+    }
+    return static_cast<unsigned short>(((pixel >> shift) & mask) * 0xFFFF / mask);
+}
+
+const XftColor *colorFor(Display *disp, int screen, unsigned long pixel) {
+    Visual *visual = DefaultVisual(disp, screen);
+    Colormap colmap = DefaultColormap(disp, screen);
+    XftColors::key_type key(pixel, colmap);
+    XftColors::iterator it = s_colors.find(key);
+    if (it != s_colors.end())
+        return &it->second.color;
+
+    if (s_colors.size() >= MAX_COLORS) {
+        for (it = s_colors.begin(); it != s_colors.end(); ++it)
+            XftColorFree(disp, it->second.visual, it->first.second, &it->second.color);
+        s_colors.clear();
+    }
+
+    // a TrueColor pixel holds its color, others are looked up once
+    XRenderColor rendcol;
+    if (visual->c_class == TrueColor) {
+        rendcol.red = channel(pixel, visual->red_mask);
+        rendcol.green = channel(pixel, visual->green_mask);
+        rendcol.blue = channel(pixel, visual->blue_mask);
+    } else {
+        XColor xcol;
+        xcol.pixel = pixel;
+        XQueryColor(disp, colmap, &xcol);
+        rendcol.red = xcol.red;
+        rendcol.green = xcol.green;
+        rendcol.blue = xcol.blue;
+    }
+    rendcol.alpha = 0xFFFF;
+
+    CachedColor cached;
+    cached.visual = visual;
+    if (!XftColorAllocValue(disp, visual, colmap, &rendcol, &cached.color))
+        return 0;
+    return &s_colors.insert(XftColors::value_type(key, cached)).first->second.color;
+}
+
+// characters below this are ASCII and Latin, their advances are kept in an array
+const unsigned int DENSE_CHARS = 0x250;
+// the other characters' advances are dropped past this many
+const size_t MAX_MORE_ADVANCES = 4096;
+const int UNMEASURED = INT_MIN;
+
+/// @return the length of the UTF-8 character at text, 0 if it isn't one
+unsigned int decodeUtf8(const unsigned char *text, unsigned int len, unsigned int &ch) {
+    unsigned int size;
+    if (text[0] < 0x80) {
+        ch = text[0];
+        return 1;
+    } else if ((text[0] & 0xE0) == 0xC0) {
+        ch = text[0] & 0x1F;
+        size = 2;
+    } else if ((text[0] & 0xF0) == 0xE0) {
+        ch = text[0] & 0x0F;
+        size = 3;
+    } else if ((text[0] & 0xF8) == 0xF0) {
+        ch = text[0] & 0x07;
+        size = 4;
+    } else
+        return 0;
+
+    if (size > len)
+        return 0;
+    for (unsigned int i = 1; i < size; ++i) {
+        if ((text[i] & 0xC0) != 0x80)
+            return 0;
+        ch = (ch << 6) | (text[i] & 0x3F);
+    }
+    return size;
+}
+
+} // end of anonymous namespace
+
 XftFontImp::XftFontImp(const char *name, bool utf8):
     m_utf8mode(utf8), m_name(""), m_maxlength(0x8000) {
 
@@ -71,6 +172,8 @@ bool XftFontImp::load(const std::string &name) {
     m_xftfonts[ROT0] = newxftfont;
     m_xftfonts_loaded[ROT0] = true;
     m_name = name;
+    m_advances.clear();
+    m_more_advances.clear();
 
     // XGlyphInfo (used by XftFontImp::textWidth() / XftTextExtents8() etc)
     // holds only type 'short' or 'unsigned short'. any text bigger than that
@@ -108,31 +211,20 @@ void XftFontImp::drawText(const FbDrawable &w, int screen, GC gc, const char* te
         break;
     }
 
-    Visual* def_visual = DefaultVisual(w.display(), screen);
-    Colormap def_colmap = DefaultColormap(w.display(), screen);
-
     XftFont *font = m_xftfonts[orient];
-    XftDraw *draw = XftDrawCreate(w.display(), w.drawable(), def_visual, def_colmap);
 
+    // the foreground comes from Xlib's copy of the GC, not the server
     XGCValues gc_val;
-
-    // get foreground pixel value and convert it to XRenderColor value
-    // TODO: we should probably check return status
     XGetGCValues(w.display(), gc, GCForeground, &gc_val);
+    const XftColor *xftcolor = colorFor(w.display(), screen, gc_val.foreground);
+    if (xftcolor == 0)
+        return;
 
-    // get red, green, blue values
-    XColor xcol;
-    xcol.pixel = gc_val.foreground;
-    XQueryColor(w.display(), def_colmap, &xcol);
-
-    // convert xcolor to XftColor
-    XRenderColor rendcol;
-    rendcol.red = xcol.red;
-    rendcol.green = xcol.green;
-    rendcol.blue = xcol.blue;
-    rendcol.alpha = 0xFFFF;
-    XftColor xftcolor;
-    XftColorAllocValue(w.display(), def_visual, def_colmap, &rendcol, &xftcolor);
+    // the drawable may be gone by the next call, so the draw and its
+    // picture go with this one; neither waits for the server
+    XftDraw *draw = XftDrawCreate(w.display(), w.drawable(),
+                                  DefaultVisual(w.display(), screen),
+                                  DefaultColormap(w.display(), screen));
 
     // draw string
 #ifdef HAVE_XFT_UTF8_STRING
@@ -142,18 +234,14 @@ void XftFontImp::drawText(const FbDrawable &w, int screen, GC gc, const char* te
         XGlyphInfo ginfo;
         XftTextExtentsUtf8(w.display(), m_xftfonts[ROT0], (XftChar8 *)text, len, &ginfo);
         if (ginfo.xOff != 0) {
-            XftDrawStringUtf8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
-            XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
+            XftDrawStringUtf8(draw, xftcolor, font, x, y, (XftChar8 *)text, len);
             XftDrawDestroy(draw);
             return;
         }
     }
 #endif // HAVE_XFT_UTF8_STRING
 
-    XftDrawString8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
-
-
-    XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
+    XftDrawString8(draw, xftcolor, font, x, y, (XftChar8 *)text, len);
     XftDrawDestroy(draw);
 }
 
@@ -172,9 +260,13 @@ unsigned int XftFontImp::textWidth(const char* text, unsigned int len) const {
 
 #ifdef HAVE_XFT_UTF8_STRING
     if (m_utf8mode) {
-        XftTextExtentsUtf8(disp, font, (XftChar8 *)text, len, &ginfo);
-        if (ginfo.xOff != 0) {
-            return ginfo.xOff;
+        int width = 0;
+        if (!measure(text, len, INT_MAX, width)) {
+            XftTextExtentsUtf8(disp, font, (XftChar8 *)text, len, &ginfo);
+            width = ginfo.xOff;
+        }
+        if (width != 0) {
+            return width;
         }
 
         // the utf8 failed, try normal extents
@@ -191,6 +283,61 @@ unsigned int XftFontImp::textWidth(const char* text, unsigned int len) const {
     return ginfo.xOff;
 }
 
+bool XftFontImp::fitText(const char* text, unsigned int &len, int max_width, int &width) const {
+#ifdef HAVE_XFT_UTF8_STRING
+    if (m_utf8mode && m_xftfonts[ROT0] != 0) {
+        unsigned int fit = std::min(len, m_maxlength);
+        if (measure(text, fit, max_width, width) && width != 0) {
+            len = fit;
+            return true;
+        }
+    }
+#endif  //HAVE_XFT_UTF8_STRING
+    return false;
+}
+
+int XftFontImp::advance(unsigned int ch) const {
+    int *cached;
+    if (ch < DENSE_CHARS) {
+        if (m_advances.empty())
+            m_advances.resize(DENSE_CHARS, UNMEASURED);
+        cached = &m_advances[ch];
+    } else {
+        if (m_more_advances.size() >= MAX_MORE_ADVANCES)
+            m_more_advances.clear();
+        cached = &m_more_advances.insert(std::make_pair(ch, UNMEASURED)).first->second;
+    }
+
+    if (*cached == UNMEASURED) {
+        FcChar32 ucs4 = ch;
+        XGlyphInfo ginfo;
+        XftTextExtents32(App::instance()->display(), m_xftfonts[ROT0], &ucs4, 1, &ginfo);
+        *cached = ginfo.xOff;
+    }
+    return *cached;
+}
+
+bool XftFontImp::measure(const char* text, unsigned int &len, int max_width, int &width) const {
+    // Xft doesn't kern or shape, the width of a text is the sum of the
+    // advances of its characters
+    const unsigned char *str = reinterpret_cast<const unsigned char *>(text);
+    unsigned int pos = 0;
+    width = 0;
+    while (pos < len) {
+        unsigned int ch;
+        unsigned int size = decodeUtf8(str + pos, len - pos, ch);
+        if (size == 0)
+            return false;
+        int w = advance(ch);
+        if (width + w > max_width)
+            break;
+        width += w;
+        pos += size;
+    }
+    len = pos;
+    return true;
+}
+
 unsigned int XftFontImp::height() const {
     if (m_xftfonts[ROT0] == 0)
         return 0;
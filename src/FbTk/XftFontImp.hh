@@ -26,6 +26,9 @@
 
 #include <X11/Xft/Xft.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace FbTk {
 
 /// Handles Xft font drawing
@@ -36,6 +39,7 @@ public:
     bool load(const std::string &name);
     void drawText(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y , FbTk::Orientation orient);
     unsigned int textWidth(const char* text, unsigned int len) const;
+    bool fitText(const char* text, unsigned int &len, int max_width, int &width) const;
     unsigned int height() const;
     int ascent() const { return m_xftfonts[0] ? m_xftfonts[0]->ascent : 0; }
     int descent() const { return m_xftfonts[0] ? m_xftfonts[0]->descent : 0; }
@@ -44,6 +48,14 @@ public:
     bool validOrientation(FbTk::Orientation orient);
 
 private:
+    /// @return the advance of a character, Xft is asked once
+    int advance(unsigned int ch) const;
+    /**
+     * Adds up the advances of the UTF-8 text, like Xft does, up to max_width.
+     * @return false if it isn't valid UTF-8
+     */
+    bool measure(const char* text, unsigned int &len, int max_width, int &width) const;
+
     XftFont *m_xftfonts[4]; // 4 possible orientations
     bool m_xftfonts_loaded[4]; // whether we've tried loading the orientation
     // rotated xft fonts don't give proper extents info, so we keep the "real"
@@ -52,6 +64,11 @@ private:
 
     std::string m_name;
     unsigned int m_maxlength;
+
+    /// of the ASCII and Latin characters, by character
+    mutable std::vector<int> m_advances;
+    /// of the rest of the characters
+    mutable std::unordered_map<unsigned int, int> m_more_advances;
 };
 
 } // end namespace FbTk
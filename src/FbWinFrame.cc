@@ -32,6 +32,7 @@
 #include "FbTk/EventManager.hh"
 #include "FbTk/App.hh"
 #include "FbTk/SimpleCommand.hh"
+#include "FbTk/FbTime.hh"
 #include "FbTk/Compose.hh"
 #include "FbTk/Transparent.hh"
 #include "FbTk/CompareEqual.hh"
@@ -52,6 +53,9 @@ namespace {
 
 enum { UNFOCUS = 0, FOCUS, PRESSED };
 
+// the groups of faces that are rendered together, see FbWinFrame::renderFaces()
+enum { TITLEBAR_FACES = 1, HANDLE_FACES = 2, TAB_FACES = 4, BUTTON_FACES = 8 };
+
 const int s_button_size = 26;
 const long s_mask = ButtonPressMask | ButtonReleaseMask | ButtonMotionMask | EnterWindowMask | LeaveWindowMask;
 
@@ -95,6 +99,37 @@ void render(FbTk::Color &col, Pixmap &pm, unsigned int width, unsigned int heigh
 
 }
 
+/// width of the strips width invariant textures are rendered to
+const unsigned int STRIP_WIDTH = 16;
+
+/// whether every column of the rendered texture looks the same
+bool widthInvariant(const FbTk::Texture &tex) {
+    const unsigned long type = tex.type();
+    if (tex.pixmap().drawable() != 0 || (type & FbTk::Texture::PARENTRELATIVE) ||
+        (type & (FbTk::Texture::RAISED | FbTk::Texture::SUNKEN)))
+        return false;
+
+    return (type & FbTk::Texture::SOLID) ||
+        ((type & FbTk::Texture::GRADIENT) && (type & FbTk::Texture::VERTICAL));
+}
+
+/// like render(), but textures that only change from top to bottom become
+/// a narrow strip the window background tiles across its width; all
+/// frames of a height share it, and it fits any width
+void renderStrip(FbTk::Color &col, Pixmap &pm, unsigned int width, unsigned int height,
+                 const FbTk::Texture &tex, FbTk::ImageControl& ictl) {
+    if (widthInvariant(tex))
+        width = STRIP_WIDTH;
+    render(col, pm, width, height, tex, ictl);
+}
+
+/// drops a face that no longer fits, it gets rendered again when needed
+void release(Pixmap &pm, FbTk::ImageControl& ictl) {
+    if (pm)
+        ictl.removeImage(pm);
+    pm = None;
+}
+
 void bg_pm_or_color(FbTk::FbWindow& win, const Pixmap& pm, const FbTk::Color& color) {
     if (pm) {
         win.setBackgroundPixmap(pm);
@@ -234,6 +269,10 @@ void FbWinFrame::show() {
         renderAll();
         applyAll();
         clearAll();
+    } else if (m_stale_faces[m_state.focused]) {
+        renderFaces(m_state.focused);
+        applyAll();
+        clearAll();
     }
 
     if (m_tabmode == EXTERNAL && m_use_tabs)
@@ -311,6 +350,8 @@ void FbWinFrame::moveResize(int x, int y, unsigned int width, unsigned int heigh
         }
         reconfigure();
     }
+
+    m_geometry_sig.emit();
 }
 
 void FbWinFrame::quietMoveResize(int x, int y,
@@ -326,6 +367,8 @@ void FbWinFrame::quietMoveResize(int x, int y,
         m_tab_container.setMaxTotalSize(s);
         alignTabs();
     }
+
+    m_geometry_sig.emit();
 }
 
 void FbWinFrame::alignTabs() {
@@ -395,6 +438,8 @@ void FbWinFrame::alignTabs() {
     } else {
         tabs.move(tab_x, tab_y);
     }
+
+    m_geometry_sig.emit();
 }
 
 void FbWinFrame::notifyMoved(bool clear) {
@@ -466,6 +511,8 @@ void FbWinFrame::setFocus(bool newvalue) {
 
     setBorderWidth();
 
+    // the faces for this state might not have been needed so far
+    renderFaces(m_state.focused);
     applyAll();
     clearAll();
 }
@@ -952,9 +999,76 @@ void FbWinFrame::reconfigure() {
     m_shape.setPlaces(getShape());
     m_shape.setShapeOffsets(0, titlebarHeight());
 
+    m_geometry_sig.emit();
+
     // titlebar stuff rendered already by reconftitlebar
 }
 
+bool FbWinFrame::renderChangedFaces() {
+    unsigned int faces[2] = { 0, 0 };
+    bool seen = true, pressed = false, more = false;
+
+    for (int f = UNFOCUS; f <= FOCUS; ++f) {
+        FbWinFrameTheme &t = f == FOCUS ? *theme().focusedTheme() : *theme().unfocusedTheme();
+        const IconbarTheme &label = t.iconbarTheme();
+        unsigned int &frame_changes = m_theme_changes[f][0];
+        unsigned int &label_changes = m_theme_changes[f][1];
+
+        // what a load before the last one changed isn't known anymore
+        if (t.changeCount() - frame_changes > 1 || label.changeCount() - label_changes > 1)
+            more = true;
+
+        if (t.changeCount() != frame_changes) {
+            seen = false;
+            more |= !t.onlyColorsChanged();
+            if (t.titleChanged())
+                faces[f] |= TITLEBAR_FACES | TAB_FACES;
+            if (t.handleChanged())
+                faces[f] |= HANDLE_FACES;
+            if (t.buttonChanged())
+                faces[f] |= BUTTON_FACES;
+            pressed |= t.buttonPressedChanged();
+            frame_changes = t.changeCount();
+        }
+
+        if (label.changeCount() != label_changes) {
+            seen = false;
+            more |= !label.onlyColorsChanged();
+            if (label.textureChanged())
+                faces[f] |= TITLEBAR_FACES | TAB_FACES;
+            label_changes = label.changeCount();
+        }
+    }
+
+    // each of the themes signals the same load
+    if (seen)
+        return true;
+    if (more || m_need_render || !isVisible())
+        return false;
+
+    for (int f = UNFOCUS; f <= FOCUS; ++f) {
+        if (!m_use_titlebar)
+            faces[f] &= ~TITLEBAR_FACES;
+        if (!m_use_handle)
+            faces[f] &= ~HANDLE_FACES;
+        m_stale_faces[f] |= faces[f];
+    }
+
+    // a button can be pressed in either state
+    if (pressed)
+        render(m_button_face.color[PRESSED], m_button_face.pm[PRESSED],
+               m_button_size, m_button_size,
+               theme()->buttonPressedTexture(), m_imagectrl);
+
+    renderFaces(m_state.focused);
+    if (m_stale_faces[!m_state.focused] && m_screen.prerenderFrames())
+        m_prerender_timer.start();
+
+    applyAll();
+    clearAll();
+    return true;
+}
+
 void FbWinFrame::setShapingClient(FbTk::FbWindow *win, bool always_update) {
     m_shape.setShapeSource(win, 0, titlebarHeight(), always_update);
 }
@@ -1076,24 +1190,13 @@ void FbWinFrame::renderTitlebar() {
         return;
     }
 
-    typedef FbTk::ThemeProxy<FbWinFrameTheme> TP;
-    TP& ft = theme().focusedTheme();
-    TP& uft = theme().unfocusedTheme();
-
-    // render pixmaps
-    render(m_title_face.color[FOCUS], m_title_face.pm[FOCUS], m_titlebar.width(), m_titlebar.height(),
-           ft->titleTexture(), m_imagectrl);
-
-    render(m_title_face.color[UNFOCUS], m_title_face.pm[UNFOCUS], m_titlebar.width(), m_titlebar.height(),
-           uft->titleTexture(), m_imagectrl);
-
-    //!! TODO: don't render label if internal tabs
-
-    render(m_label_face.color[FOCUS], m_label_face.pm[FOCUS], m_label.width(), m_label.height(),
-           ft->iconbarTheme()->texture(), m_imagectrl);
-
-    render(m_label_face.color[UNFOCUS], m_label_face.pm[UNFOCUS], m_label.width(), m_label.height(),
-           uft->iconbarTheme()->texture(), m_imagectrl);
+    // only the faces for the current state get rendered right away
+    const int other = !m_state.focused;
+    release(m_title_face.pm[other], m_imagectrl);
+    release(m_label_face.pm[other], m_imagectrl);
+    m_stale_faces[UNFOCUS] |= TITLEBAR_FACES;
+    m_stale_faces[FOCUS] |= TITLEBAR_FACES;
+    renderFaces(m_state.focused);
 }
 
 void FbWinFrame::renderTabContainer() {
@@ -1102,26 +1205,11 @@ void FbWinFrame::renderTabContainer() {
         return;
     }
 
-    typedef FbTk::ThemeProxy<FbWinFrameTheme> TP;
-    TP& ft = theme().focusedTheme();
-    TP& uft = theme().unfocusedTheme();
-    FbTk::Container& tabs = tabcontainer();
-    const FbTk::Texture *tc_focused = &ft->iconbarTheme()->texture();
-    const FbTk::Texture *tc_unfocused = &uft->iconbarTheme()->texture();
-
-    if (m_tabmode == EXTERNAL && tc_focused->type() & FbTk::Texture::PARENTRELATIVE)
-        tc_focused = &ft->titleTexture();
-    if (m_tabmode == EXTERNAL && tc_unfocused->type() & FbTk::Texture::PARENTRELATIVE)
-        tc_unfocused = &uft->titleTexture();
-
-    render(m_tabcontainer_face.color[FOCUS], m_tabcontainer_face.pm[FOCUS],
-           tabs.width(), tabs.height(), *tc_focused, m_imagectrl, tabs.orientation());
-
-    render(m_tabcontainer_face.color[UNFOCUS], m_tabcontainer_face.pm[UNFOCUS],
-           tabs.width(), tabs.height(), *tc_unfocused, m_imagectrl, tabs.orientation());
+    release(m_tabcontainer_face.pm[!m_state.focused], m_imagectrl);
+    m_stale_faces[UNFOCUS] |= TAB_FACES;
+    m_stale_faces[FOCUS] |= TAB_FACES;
 
     renderButtons();
-
 }
 
 void FbWinFrame::applyTitlebar() {
@@ -1152,25 +1240,12 @@ void FbWinFrame::renderHandles() {
         return;
     }
 
-    typedef FbTk::ThemeProxy<FbWinFrameTheme> TP;
-    TP& ft = theme().focusedTheme();
-    TP& uft = theme().unfocusedTheme();
-
-    render(m_handle_face.color[FOCUS], m_handle_face.pm[FOCUS],
-           m_handle.width(), m_handle.height(),
-           ft->handleTexture(), m_imagectrl);
-
-    render(m_handle_face.color[UNFOCUS], m_handle_face.pm[UNFOCUS],
-           m_handle.width(), m_handle.height(),
-           uft->handleTexture(), m_imagectrl);
-
-    render(m_grip_face.color[FOCUS], m_grip_face.pm[FOCUS],
-           m_grip_left.width(), m_grip_left.height(),
-           ft->gripTexture(), m_imagectrl);
-
-    render(m_grip_face.color[UNFOCUS], m_grip_face.pm[UNFOCUS],
-           m_grip_left.width(), m_grip_left.height(),
-           uft->gripTexture(), m_imagectrl);
+    const int other = !m_state.focused;
+    release(m_handle_face.pm[other], m_imagectrl);
+    release(m_grip_face.pm[other], m_imagectrl);
+    m_stale_faces[UNFOCUS] |= HANDLE_FACES;
+    m_stale_faces[FOCUS] |= HANDLE_FACES;
+    renderFaces(m_state.focused);
 }
 
 void FbWinFrame::applyHandles() {
@@ -1195,22 +1270,71 @@ void FbWinFrame::renderButtons() {
         return;
     }
 
-    typedef FbTk::ThemeProxy<FbWinFrameTheme> TP;
-    TP& ft = theme().focusedTheme();
-    TP& uft = theme().unfocusedTheme();
-
-    render(m_button_face.color[UNFOCUS], m_button_face.pm[UNFOCUS],
-           m_button_size, m_button_size,
-           uft->buttonTexture(), m_imagectrl);
-
-    render(m_button_face.color[FOCUS], m_button_face.pm[FOCUS],
-           m_button_size, m_button_size,
-           ft->buttonTexture(), m_imagectrl);
-
+    // a button can be pressed in either state
     render(m_button_face.color[PRESSED], m_button_face.pm[PRESSED],
            m_button_size, m_button_size,
            theme()->buttonPressedTexture(), m_imagectrl);
 
+    release(m_button_face.pm[!m_state.focused], m_imagectrl);
+    m_stale_faces[UNFOCUS] |= BUTTON_FACES;
+    m_stale_faces[FOCUS] |= BUTTON_FACES;
+    renderFaces(m_state.focused);
+}
+
+void FbWinFrame::renderFaces(bool focused) {
+    unsigned int &stale = m_stale_faces[focused];
+    if (stale == 0 || !isVisible())
+        return;
+
+    FbTk::ThemeProxy<FbWinFrameTheme> &t =
+        focused ? theme().focusedTheme() : theme().unfocusedTheme();
+
+    if (stale & TITLEBAR_FACES) {
+        renderStrip(m_title_face.color[focused], m_title_face.pm[focused],
+                    m_titlebar.width(), m_titlebar.height(),
+                    t->titleTexture(), m_imagectrl);
+
+        //!! TODO: don't render label if internal tabs
+
+        renderStrip(m_label_face.color[focused], m_label_face.pm[focused],
+                    m_label.width(), m_label.height(),
+                    t->iconbarTheme()->texture(), m_imagectrl);
+    }
+
+    if (stale & HANDLE_FACES) {
+        renderStrip(m_handle_face.color[focused], m_handle_face.pm[focused],
+                    m_handle.width(), m_handle.height(),
+                    t->handleTexture(), m_imagectrl);
+
+        render(m_grip_face.color[focused], m_grip_face.pm[focused],
+               m_grip_left.width(), m_grip_left.height(),
+               t->gripTexture(), m_imagectrl);
+    }
+
+    if (stale & TAB_FACES) {
+        FbTk::Container& tabs = tabcontainer();
+        const FbTk::Texture *tex = &t->iconbarTheme()->texture();
+        if (m_tabmode == EXTERNAL && tex->type() & FbTk::Texture::PARENTRELATIVE)
+            tex = &t->titleTexture();
+
+        render(m_tabcontainer_face.color[focused], m_tabcontainer_face.pm[focused],
+               tabs.width(), tabs.height(), *tex, m_imagectrl, tabs.orientation());
+    }
+
+    if (stale & BUTTON_FACES) {
+        render(m_button_face.color[focused], m_button_face.pm[focused],
+               m_button_size, m_button_size,
+               t->buttonTexture(), m_imagectrl);
+    }
+
+    stale = 0;
+
+    if (m_stale_faces[!focused] && m_screen.prerenderFrames())
+        m_prerender_timer.start();
+}
+
+void FbWinFrame::prerenderFaces() {
+    renderFaces(!m_state.focused);
 }
 
 void FbWinFrame::applyButtons() {
@@ -1239,6 +1363,18 @@ void FbWinFrame::init() {
     m_handle_face.pm[UNFOCUS] = m_handle_face.pm[FOCUS] = 0;
     m_button_face.pm[UNFOCUS] = m_button_face.pm[FOCUS] = m_button_face.pm[PRESSED] = 0;
     m_grip_face.pm[UNFOCUS] = m_grip_face.pm[FOCUS] = 0;
+    m_stale_faces[UNFOCUS] = m_stale_faces[FOCUS] = 0;
+    for (int f = UNFOCUS; f <= FOCUS; ++f) {
+        FbWinFrameTheme &t = f == FOCUS ? *theme().focusedTheme() : *theme().unfocusedTheme();
+        m_theme_changes[f][0] = t.changeCount();
+        m_theme_changes[f][1] = t.iconbarTheme().changeCount();
+    }
+
+    // renders the faces of the state that isn't shown once things calm down
+    m_prerender_timer.setTimeout(500 * FbTk::FbTime::IN_MILLISECONDS);
+    m_prerender_timer.fireOnce(true);
+    FbTk::RefCount<FbTk::Command<void> > prerender(new FbTk::SimpleCommand<FbWinFrame>(*this, &FbWinFrame::prerenderFaces));
+    m_prerender_timer.setCommand(prerender);
 
     m_button_size = s_button_size;
 
@@ -1360,6 +1496,8 @@ void FbWinFrame::applyDecorations(bool do_move) {
     }
     if (client_move)
         frameExtentSig().emit();
+
+    m_geometry_sig.emit();
 }
 
 bool FbWinFrame::setBorderWidth(bool do_move) {
@@ -1419,6 +1557,8 @@ bool FbWinFrame::setBorderWidth(bool do_move) {
             move(grav_x + x(), grav_y + y());
     }
 
+    m_geometry_sig.emit();
+
     return true;
 }
 
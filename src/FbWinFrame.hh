@@ -33,6 +33,7 @@
 #include "FbTk/Container.hh"
 #include "FbTk/Shape.hh"
 #include "FbTk/Signal.hh"
+#include "FbTk/Timer.hh"
 
 #include <vector>
 #include <memory>
@@ -173,6 +174,11 @@ public:
     //@}
 
     void reconfigure();
+    /**
+     * After a style load, renders just the faces whose textures changed.
+     * @return false if more than textures changed, so reconfigure() is due
+     */
+    bool renderChangedFaces();
     void setShapingClient(FbTk::FbWindow *win, bool always_update);
     void updateShape() { m_shape.update(); }
 
@@ -225,6 +231,8 @@ public:
     FbTk::LayerItem &layerItem() { return m_layeritem; }
 
     FbTk::Signal<> &frameExtentSig() { return m_frame_extent_sig; }
+    /// emitted when the area covered by the frame (or its tabs) might have changed
+    FbTk::Signal<> &geometrySig() { return m_geometry_sig; }
     /// @returns true if the window is inside titlebar, 
     /// assuming window is an event window that was generated for this frame.
     bool insideTitlebar(Window win) const;
@@ -251,6 +259,11 @@ private:
 
     void renderButtons(); // subset of renderTitlebar - don't call directly
 
+    /// renders the faces of the given focus state that are out of date
+    void renderFaces(bool focused);
+    /// renders the faces of the state not shown, if the screen wants that
+    void prerenderFaces();
+
     //@}
 
     // these return true/false for if something changed
@@ -313,6 +326,7 @@ private:
     //@}
 
     FbTk::Signal<> m_frame_extent_sig;
+    FbTk::Signal<> m_geometry_sig;
 
     typedef std::vector<FbTk::Button *> ButtonList;
     ButtonList m_buttons_left, ///< buttons to the left
@@ -349,6 +363,10 @@ private:
     unsigned int m_active_orig_client_bw;
 
     bool m_need_render;
+    unsigned int m_stale_faces[2]; ///< 0-unfocus, 1-focus: faces to render before showing them
+    /// changeCount() of the frame and the label theme of each focus state, as last rendered
+    unsigned int m_theme_changes[2][2];
+    FbTk::Timer m_prerender_timer;
     int m_button_size; ///< size for all titlebar buttons
     int m_alpha[2]; // 0-unfocused, 1-focused
 
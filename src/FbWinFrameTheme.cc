@@ -87,6 +87,14 @@ bool FbWinFrameTheme::fallback(FbTk::ThemeItem_base &item) {
     return false;
 }
 
+bool FbWinFrameTheme::onlyColorsChanged() const {
+    const FbTk::ThemeItem_base *colors[] = {
+        &m_title, &m_handle, &m_button, &m_button_pressed, &m_grip,
+        &m_button_color
+    };
+    return onlyChanged(colors, sizeof(colors) / sizeof(colors[0]));
+}
+
 void FbWinFrameTheme::reconfigTheme() {
     *m_bevel_width = FbTk::Util::clamp(*m_bevel_width, 0, 20);
     if (*m_handle_width < 0)
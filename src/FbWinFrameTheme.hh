@@ -50,6 +50,18 @@ public:
     const FbTk::Texture &gripTexture() const { return *m_grip; }
     //@}
 
+    /**
+       @name what the last load that changed the theme changed
+    */
+    //@{
+    bool titleChanged() const { return changed(m_title); }
+    bool handleChanged() const { return changed(m_handle) || changed(m_grip); }
+    bool buttonChanged() const { return changed(m_button); }
+    bool buttonPressedChanged() const { return changed(m_button_pressed); }
+    /// @return true if nothing but the textures and the button color changed
+    bool onlyColorsChanged() const;
+    //@}
+
     const FbTk::Color &buttonColor() const { return *m_button_color; }
     FbTk::Font &font() { return *m_font; }
     GC buttonPicGC() const { return m_button_pic_gc.gc(); }
@@ -75,7 +87,11 @@ public:
     unsigned int handleWidth() const { return *m_handle_width; }
 
     int alpha() const { return m_alpha; }
-    void setAlpha(int alpha) { m_alpha = alpha; }
+    void setAlpha(int alpha) {
+        if (alpha != m_alpha)
+            setChanged();
+        m_alpha = alpha;
+    }
 
     IconbarTheme &iconbarTheme() { return m_iconbar_theme; }
 
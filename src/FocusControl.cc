@@ -35,6 +35,7 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <vector>
 #ifdef HAVE_CSTRING
   #include <cstring>
 #else
@@ -345,84 +346,122 @@ void FocusControl::dirFocus(FluxboxWindow &win, FocusDir dir) {
         left = win.x() + borderW,
         right = win.x() + win.width() + borderW;
 
-    Workspace::Windows &wins = m_screen.currentWorkspace()->windowList();
-    Workspace::Windows::iterator it = wins.begin();
-    for (; it != wins.end(); ++it) {
-        if ((*it) == &win
-            || (*it)->isIconic()
-            || (*it)->isFocusHidden()
-            || !(*it)->acceptsFocus())
-            continue; // skip self
-
-        // we check things against an edge, and within the bounds (draw a picture)
-        int edge=0, upper=0, lower=0, oedge=0, oupper=0, olower=0;
-
-        int otop = (*it)->y() + borderW,
-            // 2 * border = border on each side
-            obottom = (*it)->y() + (*it)->height() + borderW,
-            oleft = (*it)->x() + borderW,
-            // 2 * border = border on each side
-            oright = (*it)->x() + (*it)->width() + borderW;
-
-        // check if they intersect
-        switch (dir) {
-        case FOCUSUP:
-            edge = obottom;
-            oedge = bottom;
-            upper = left;
-            oupper = oleft;
-            lower = right;
-            olower = oright;
-            break;
-        case FOCUSDOWN:
-            edge = top;
-            oedge = otop;
-            upper = left;
-            oupper = oleft;
-            lower = right;
-            olower = oright;
-            break;
-        case FOCUSLEFT:
-            edge = oright;
-            oedge = right;
-            upper = top;
-            oupper = otop;
-            lower = bottom;
-            olower = obottom;
-            break;
-        case FOCUSRIGHT:
-            edge = left;
-            oedge = oleft;
-            upper = top;
-            oupper = otop;
-            lower = bottom;
-            olower = obottom;
-            break;
-        }
+    // Windows in the band straight ahead of us always beat the ones off to
+    // the side, so look at those first and only fall back to everything
+    // on the workspace when the band is empty.
+    const int FAR_AWAY = 1 << 20;
+    int band_x = win.x(), band_y = win.y();
+    int band_w = win.width(), band_h = win.height();
+    switch (dir) {
+    case FOCUSUP:
+        band_y = -FAR_AWAY;
+        band_h = win.y() + win.height() + FAR_AWAY;
+        break;
+    case FOCUSDOWN:
+        band_h = FAR_AWAY;
+        break;
+    case FOCUSLEFT:
+        band_x = -FAR_AWAY;
+        band_w = win.x() + win.width() + FAR_AWAY;
+        break;
+    case FOCUSRIGHT:
+        band_w = FAR_AWAY;
+        break;
+    }
 
-        if (oedge < edge)
-            continue; // not in the right direction
+    Workspace *ws = m_screen.currentWorkspace();
+    std::vector<FluxboxWindow *> wins;
+    ws->findWindows(-1, band_x, band_y, band_w, band_h, wins);
 
-        if (olower <= upper || oupper >= lower) {
-            // outside our horz bounds, get a heavy weight penalty
-            int myweight = 100000 + oedge - edge + abs(upper-oupper)+abs(lower-olower);
-            if (myweight < weight) {
-                foundwin = *it;
-                exposure = 0;
-                weight = myweight;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            if (foundwin && weight < 100000)
+                break;
+            foundwin = 0;
+            weight = 999999;
+            exposure = 0;
+            wins.clear();
+            ws->findWindows(-1, -FAR_AWAY, -FAR_AWAY, 2 * FAR_AWAY, 2 * FAR_AWAY, wins);
+        }
+
+        std::vector<FluxboxWindow *>::iterator it = wins.begin();
+        for (; it != wins.end(); ++it) {
+            if ((*it) == &win
+                || (*it)->isIconic()
+                || (*it)->isFocusHidden()
+                || !(*it)->acceptsFocus())
+                continue; // skip self
+
+            // we check things against an edge, and within the bounds (draw a picture)
+            int edge=0, upper=0, lower=0, oedge=0, oupper=0, olower=0;
+
+            int otop = (*it)->y() + borderW,
+                // 2 * border = border on each side
+                obottom = (*it)->y() + (*it)->height() + borderW,
+                oleft = (*it)->x() + borderW,
+                // 2 * border = border on each side
+                oright = (*it)->x() + (*it)->width() + borderW;
+
+            // check if they intersect
+            switch (dir) {
+            case FOCUSUP:
+                edge = obottom;
+                oedge = bottom;
+                upper = left;
+                oupper = oleft;
+                lower = right;
+                olower = oright;
+                break;
+            case FOCUSDOWN:
+                edge = top;
+                oedge = otop;
+                upper = left;
+                oupper = oleft;
+                lower = right;
+                olower = oright;
+                break;
+            case FOCUSLEFT:
+                edge = oright;
+                oedge = right;
+                upper = top;
+                oupper = otop;
+                lower = bottom;
+                olower = obottom;
+                break;
+            case FOCUSRIGHT:
+                edge = left;
+                oedge = oleft;
+                upper = top;
+                oupper = otop;
+                lower = bottom;
+                olower = obottom;
+                break;
             }
-        } else if ((oedge - edge) < weight) {
-            foundwin = *it;
-            weight = oedge - edge;
-            exposure = ((lower < olower)?lower:olower) - ((upper > oupper)?upper:oupper);
-        } else if (foundwin && oedge - edge == weight) {
-            int myexp = ((lower < olower)?lower:olower) - ((upper > oupper)?upper:oupper);
-            if (myexp > exposure) {
+
+            if (oedge < edge)
+                continue; // not in the right direction
+
+            if (olower <= upper || oupper >= lower) {
+                // outside our horz bounds, get a heavy weight penalty
+                int myweight = 100000 + oedge - edge + abs(upper-oupper)+abs(lower-olower);
+                if (myweight < weight) {
+                    foundwin = *it;
+                    exposure = 0;
+                    weight = myweight;
+                }
+            } else if ((oedge - edge) < weight) {
                 foundwin = *it;
-                // weight is same
-                exposure = myexp;
-            }
-        } // else not improvement
+                weight = oedge - edge;
+                exposure = ((lower < olower)?lower:olower) - ((upper > oupper)?upper:oupper);
+            } else if (foundwin && oedge - edge == weight) {
+                int myexp = ((lower < olower)?lower:olower) - ((upper > oupper)?upper:oupper);
+                if (myexp > exposure) {
+                    foundwin = *it;
+                    // weight is same
+                    exposure = myexp;
+                }
+            } // else not improvement
+        }
     }
 
     if (foundwin)
@@ -0,0 +1,138 @@
+// FreeSpace.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FreeSpace.hh"
+
+#include <cstddef>
+
+using std::vector;
+
+namespace {
+
+typedef FreeSpace::Rect Rect;
+
+Rect makeRect(int x, int y, int width, int height) {
+    Rect r = { x, y, width, height };
+    return r;
+}
+
+bool contains(const Rect &outer, const Rect &inner) {
+    return outer.x <= inner.x && outer.y <= inner.y &&
+           outer.x + outer.width >= inner.x + inner.width &&
+           outer.y + outer.height >= inner.y + inner.height;
+}
+
+} // end of anonymous namespace
+
+FreeSpace::FreeSpace():
+    m_x(0), m_y(0), m_width(0), m_height(0) {
+}
+
+void FreeSpace::reset(int x, int y, int width, int height) {
+    m_x = x;
+    m_y = y;
+    m_width = width;
+    m_height = height;
+
+    m_rects.clear();
+    if (width > 0 && height > 0)
+        m_rects.push_back(makeRect(x, y, width, height));
+}
+
+void FreeSpace::occupy(int x, int y, int width, int height) {
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    const int right = x + width, bottom = y + height;
+
+    // split every rectangle we cut into the (up to four) maximal pieces
+    // left around the occupied part
+    vector<Rect> kept, pieces;
+    for (size_t i = 0; i < m_rects.size(); ++i) {
+        const Rect &r = m_rects[i];
+        const int r_right = r.x + r.width, r_bottom = r.y + r.height;
+        if (x >= r_right || right <= r.x || y >= r_bottom || bottom <= r.y) {
+            kept.push_back(r);
+            continue;
+        }
+
+        if (x > r.x)
+            pieces.push_back(makeRect(r.x, r.y, x - r.x, r.height));
+        if (right < r_right)
+            pieces.push_back(makeRect(right, r.y, r_right - right, r.height));
+        if (y > r.y)
+            pieces.push_back(makeRect(r.x, r.y, r.width, y - r.y));
+        if (bottom < r_bottom)
+            pieces.push_back(makeRect(r.x, bottom, r.width, r_bottom - bottom));
+    }
+
+    if (kept.size() == m_rects.size())
+        return; // nothing changed
+
+    // untouched rectangles are still maximal, but a piece may lie within
+    // another piece or an untouched rectangle
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        bool redundant = false;
+        for (size_t j = 0; j < kept.size() && !redundant; ++j)
+            redundant = contains(kept[j], pieces[i]);
+        for (size_t j = 0; j < pieces.size() && !redundant; ++j) {
+            if (j == i || !contains(pieces[j], pieces[i]))
+                continue;
+            // of two equal pieces only keep the first one
+            redundant = !contains(pieces[i], pieces[j]) || j < i;
+        }
+        if (!redundant)
+            kept.push_back(pieces[i]);
+    }
+
+    m_rects.swap(kept);
+}
+
+bool FreeSpace::find(int width, int height, bool rows, bool left_right, bool top_bottom,
+                     int &x, int &y) const {
+
+    bool found = false;
+    for (size_t i = 0; i < m_rects.size(); ++i) {
+        const Rect &r = m_rects[i];
+        if (r.width < width || r.height < height)
+            continue;
+
+        // the best spot within this rectangle is one of its corners
+        const int cx = left_right ? r.x : r.x + r.width - width;
+        const int cy = top_bottom ? r.y : r.y + r.height - height;
+
+        if (found) {
+            const bool x_better = left_right ? cx < x : cx > x;
+            const bool y_better = top_bottom ? cy < y : cy > y;
+            const bool better = rows ? (y_better || (cy == y && x_better))
+                                     : (x_better || (cx == x && y_better));
+            if (!better)
+                continue;
+        }
+
+        x = cx;
+        y = cy;
+        found = true;
+    }
+
+    return found;
+}
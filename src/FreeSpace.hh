@@ -0,0 +1,73 @@
+// FreeSpace.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FREESPACE_HH
+#define FREESPACE_HH
+
+#include <vector>
+
+/**
+ * The unoccupied part of an area, as the list of its maximal free
+ * rectangles.
+ *
+ * Any window that fits into the free space fits into one of these
+ * rectangles, so finding a spot is a walk over the (few) rectangles
+ * instead of a scan over positions. Occupying space splits the rectangles
+ * it touches; freeing space is not supported, start over with reset().
+ * Rectangles are half open: a window ending at x does not occupy x.
+ */
+class FreeSpace {
+public:
+    struct Rect {
+        int x, y, width, height;
+    };
+
+    FreeSpace();
+
+    /// makes the whole area free
+    void reset(int x, int y, int width, int height);
+
+    /// removes the given rectangle from the free space
+    void occupy(int x, int y, int width, int height);
+
+    /// @return whether the area was given as x, y, width, height
+    bool hasBounds(int x, int y, int width, int height) const {
+        return m_x == x && m_y == y && m_width == width && m_height == height;
+    }
+
+    const std::vector<Rect> &rects() const { return m_rects; }
+
+    /**
+     * Finds the first free spot for a width x height window.
+     * @param rows whether rows (y first) or columns (x first) are filled
+     * @param left_right whether rows are filled from the left
+     * @param top_bottom whether columns are filled from the top
+     * @return false if the window doesn't fit anywhere
+     */
+    bool find(int width, int height, bool rows, bool left_right, bool top_bottom,
+              int &x, int &y) const;
+
+private:
+    int m_x, m_y, m_width, m_height;
+    std::vector<Rect> m_rects;
+};
+
+#endif // FREESPACE_HH
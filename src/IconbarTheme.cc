@@ -41,6 +41,11 @@ IconbarTheme::~IconbarTheme() {
 }
 
 
+bool IconbarTheme::onlyColorsChanged() const {
+    const FbTk::ThemeItem_base *colors[] = { &m_texture, &m_empty_texture };
+    return onlyChanged(colors, 2);
+}
+
 void IconbarTheme::reconfigTheme() {
     m_text.updateTextColor();
 }
@@ -41,6 +41,11 @@ public:
     const FbTk::Texture &texture() const { return *m_texture; }
     const FbTk::Texture &emptyTexture() const { return *m_empty_texture; }
 
+    bool textureChanged() const { return changed(m_texture); }
+    bool emptyTextureChanged() const { return changed(m_empty_texture); }
+    /// @return true if the last load that changed the theme only changed textures
+    bool onlyColorsChanged() const;
+
     virtual FbTk::Signal<> &reconfigSig() { return FbTk::Theme::reconfigSig(); }
 
     virtual IconbarTheme &operator *() { return *this; }
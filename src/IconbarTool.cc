@@ -282,9 +282,9 @@ IconbarTool::IconbarTool(const FbTk::FbWindow &parent, IconbarTheme &theme,
     // setup signals
     m_tracker.join(theme.reconfigSig(), FbTk::MemFun(*this, &IconbarTool::themeReconfigured));
     m_tracker.join(focused_theme.reconfigSig(),
-            FbTk::MemFun(*this, &IconbarTool::themeReconfigured));
+            FbTk::MemFunBind(*this, &IconbarTool::buttonThemeReconfigured, true));
     m_tracker.join(unfocused_theme.reconfigSig(),
-            FbTk::MemFun(*this, &IconbarTool::themeReconfigured));
+            FbTk::MemFunBind(*this, &IconbarTool::buttonThemeReconfigured, false));
     m_tracker.join(screen.reconfigureSig(),
             FbTk::MemFunIgnoreArgs(*this, &IconbarTool::updateIconifiedPattern));
 
@@ -293,7 +293,7 @@ IconbarTool::IconbarTool(const FbTk::FbWindow &parent, IconbarTheme &theme,
     FbTk::RefCount<FbTk::Command<void> > ers(new FbTk::SimpleCommand<IconbarTool>(*this, &IconbarTool::emitResizeSig));
     m_resizeSig_timer.setCommand(ers);
 
-    themeReconfigured();
+    setMode(*m_rc_mode);
 }
 
 IconbarTool::~IconbarTool() {
@@ -407,7 +407,36 @@ unsigned int IconbarTool::borderWidth() const {
 }
 
 void IconbarTool::themeReconfigured() {
-    setMode(*m_rc_mode);
+    if (!m_theme.onlyColorsChanged()) {
+        renderTheme();
+        m_resizeSig_timer.start();
+        return;
+    }
+
+    if (m_theme.emptyTextureChanged()) {
+        renderEmptyTexture();
+        m_icon_container.clear();
+    }
+}
+
+void IconbarTool::buttonThemeReconfigured(bool focused) {
+    const IconbarTheme &theme = focused ? *m_focused_theme : *m_unfocused_theme;
+    if (!theme.onlyColorsChanged()) {
+        renderTheme();
+        m_resizeSig_timer.start();
+        return;
+    }
+
+    if (!theme.textureChanged())
+        return;
+
+    IconMap::iterator icon_it = m_icons.begin();
+    const IconMap::iterator icon_it_end = m_icons.end();
+    for (; icon_it != icon_it_end; ++icon_it) {
+        const Focusable &win = *icon_it->first;
+        if ((win.isFocused() || win.getAttentionState()) == focused)
+            renderButton(*icon_it->second);
+    }
 }
 
 void IconbarTool::update(UpdateReason reason, Focusable *win) {
@@ -521,6 +550,19 @@ void IconbarTool::renderTheme() {
     // update button sizes before we get max width per client!
     updateSizing();
 
+    renderEmptyTexture();
+
+    m_icon_container.setAlpha(m_alpha);
+
+    // update buttons
+    IconMap::iterator icon_it = m_icons.begin();
+    const IconMap::iterator icon_it_end = m_icons.end();
+    for (; icon_it != icon_it_end; ++icon_it)
+        renderButton(*icon_it->second);
+
+}
+
+void IconbarTool::renderEmptyTexture() {
     // if we dont have any icons then we should render empty texture
     if (!m_theme.emptyTexture().usePixmap()) {
         m_empty_pm.reset( 0 );
@@ -532,15 +574,6 @@ void IconbarTool::renderTheme() {
                                       m_theme.emptyTexture(), orientation()));
         m_icon_container.setBackgroundPixmap(m_empty_pm);
     }
-
-    m_icon_container.setAlpha(m_alpha);
-
-    // update buttons
-    IconMap::iterator icon_it = m_icons.begin();
-    const IconMap::iterator icon_it_end = m_icons.end();
-    for (; icon_it != icon_it_end; ++icon_it)
-        renderButton(*icon_it->second);
-
 }
 
 void IconbarTool::renderButton(IconButton &button, bool clear) {
@@ -85,6 +85,8 @@ private:
     /// render all buttons
     void renderTheme();
     void renderTheme(int alpha);
+    /// render the background where there are no buttons
+    void renderEmptyTexture();
     /// destroy all icons
     void deleteIcons();
     /// add or move a single window
@@ -104,6 +106,8 @@ private:
     void updateIconifiedPattern();
 
     void themeReconfigured();
+    /// a new style only renders the buttons in that state if just textures changed
+    void buttonThemeReconfigured(bool focused);
 
     FbTk::Timer m_resizeSig_timer;
     void emitResizeSig();
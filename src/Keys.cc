@@ -26,6 +26,7 @@
 #include "WinClient.hh"
 #include "WindowCmd.hh"
 #include "Debug.hh"
+#include "BindingIndex.hh"
 
 #include "FbTk/EventManager.hh"
 #include "FbTk/StringUtil.hh"
@@ -142,19 +143,21 @@ public:
             const std::string &key_str = std::string(), int context = 0,
             bool isdouble = false);
 
+    /// @param mod_ the modifiers, already passed through isolateModifierMask()
     RefKey find(int type_, unsigned int mod_, unsigned int key_,
                 int context_, bool isdouble_) {
         // t_key ctor sets context_ of 0 to GLOBAL, so we must here too
         context_ = context_ ? context_ : GLOBAL;
-        keylist_t::iterator it = keylist.begin(), it_end = keylist.end();
-        for (; it != it_end; ++it) {
-            if (*it && (*it)->type == type_ && (*it)->key == key_ &&
-                ((*it)->context & context_) > 0 &&
-                isdouble_ == (*it)->isdouble && (*it)->mod ==
-                FbTk::KeyUtil::instance().isolateModifierMask(mod_))
-                return *it;
+        if (!indexed) {
+            index.build(keylist.begin(), keylist.end());
+            indexed = true;
         }
-        return RefKey();
+        return index.find(type_, mod_, key_, context_, isdouble_);
+    }
+
+    void add(const RefKey &k) {
+        keylist.push_back(k);
+        indexed = false;
     }
 
     // member variables
@@ -167,7 +170,9 @@ public:
     bool isdouble;
     FbTk::RefCount<FbTk::Command<void> > m_command;
 
-    keylist_t keylist;
+    keylist_t keylist; ///< use add() to change it, it is indexed
+    BindingIndex<RefKey> index; ///< keylist by type, key and modifiers
+    bool indexed; ///< whether index is up to date
 };
 
 Keys::t_key::t_key(int type_, unsigned int mod_, unsigned int key_,
@@ -179,7 +184,8 @@ Keys::t_key::t_key(int type_, unsigned int mod_, unsigned int key_,
     key_str(key_str_),
     context(context_),
     isdouble(isdouble_),
-    m_command(0) {
+    m_command(0),
+    indexed(false) {
 
     context = context_ ? context_ : GLOBAL;
 }
@@ -208,17 +214,6 @@ void Keys::deleteTree() {
     saved_keymode.reset();
 }
 
-// keys are only grabbed in global context
-void Keys::grabKey(unsigned int key, unsigned int mod) {
-    WindowMap::iterator it = m_window_map.begin();
-    WindowMap::iterator it_end = m_window_map.end();
-
-    for (; it != it_end; ++it) {
-        if ((it->second & Keys::GLOBAL) > 0)
-            FbTk::KeyUtil::grabKey(key, mod, it->first);
-    }
-}
-
 // keys are only grabbed in global context
 void Keys::ungrabKeys() {
     WindowMap::iterator it = m_window_map.begin();
@@ -230,18 +225,6 @@ void Keys::ungrabKeys() {
     }
 }
 
-// ON_DESKTOP context doesn't need to be grabbed
-void Keys::grabButton(unsigned int button, unsigned int mod, int context) {
-    WindowMap::iterator it = m_window_map.begin();
-    WindowMap::iterator it_end = m_window_map.end();
-
-    for (; it != it_end; ++it) {
-        if ((context & it->second & ~Keys::ON_DESKTOP) > 0)
-            FbTk::KeyUtil::grabButton(button, mod, it->first,
-                                      ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
-    }
-}
-
 void Keys::ungrabButtons() {
     WindowMap::iterator it = m_window_map.begin();
     WindowMap::iterator it_end = m_window_map.end();
@@ -250,32 +233,43 @@ void Keys::ungrabButtons() {
         FbTk::KeyUtil::ungrabButtons(it->first);
 }
 
-void Keys::grabWindow(Window win) {
+void Keys::wantGrabs(Window win, int context) {
+    m_grabs.clearWanted(win);
     if (!m_keylist)
         return;
 
-    // make sure the window is in our list
-    WindowMap::iterator win_it = m_window_map.find(win);
-    if (win_it == m_window_map.end())
-        return;
-
-    m_handler_map[win]->grabButtons();
     t_key::keylist_t::iterator it = m_keylist->keylist.begin();
     t_key::keylist_t::iterator it_end = m_keylist->keylist.end();
     for (; it != it_end; ++it) {
         // keys are only grabbed in global context
-        if ((win_it->second & Keys::GLOBAL) > 0 && (*it)->type == KeyPress)
-            FbTk::KeyUtil::grabKey((*it)->key, (*it)->mod, win);
+        if ((context & Keys::GLOBAL) > 0 && (*it)->type == KeyPress)
+            m_grabs.wantKey((*it)->key, (*it)->mod, win);
         // ON_DESKTOP buttons don't need to be grabbed
-        else if ((win_it->second & (*it)->context & ~Keys::ON_DESKTOP) > 0) {
+        else if ((context & (*it)->context & ~Keys::ON_DESKTOP) > 0) {
 
             if ((*it)->type == ButtonPress || (*it)->type == ButtonRelease || (*it)->type == MotionNotify) {
-                FbTk::KeyUtil::grabButton((*it)->key, (*it)->mod, win, ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
+                m_grabs.wantButton((*it)->key, (*it)->mod, win, ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
             }
         }
     }
 }
 
+void Keys::commitGrabs() {
+    vector<Window> reset;
+    m_grabs.commit(reset);
+    if (reset.empty())
+        return;
+
+    // these windows lost all their button grabs, including the ones
+    // their handlers hold themselves
+    for (size_t i = 0; i < reset.size(); ++i) {
+        HandlerMap::iterator handler = m_handler_map.find(reset[i]);
+        if (handler != m_handler_map.end())
+            handler->second->grabButtons();
+    }
+    m_grabs.commit(reset);
+}
+
 /**
     Load and grab keys
     TODO: error checking
@@ -484,8 +478,9 @@ bool Keys::addBinding(const string &linebuffer) {
 
                 if (!first_new_key) {
                     first_new_keylist = current_key;
-                    current_key = current_key->find(type, mod, key, context,
-                                                    isdouble);
+                    current_key = current_key->find(type,
+                            FbTk::KeyUtil::instance().isolateModifierMask(mod),
+                            key, context, isdouble);
                     if (!current_key) {
                         first_new_key.reset( new t_key(type, mod, key, key_str, context,
                                                   isdouble) );
@@ -495,7 +490,7 @@ bool Keys::addBinding(const string &linebuffer) {
                 } else {
                     RefKey temp_key( new t_key(type, mod, key, key_str, context,
                                                 isdouble) );
-                    current_key->keylist.push_back(temp_key);
+                    current_key->add(temp_key);
                     current_key = temp_key;
                 }
                 mod = 0;
@@ -517,7 +512,7 @@ bool Keys::addBinding(const string &linebuffer) {
                 return false;
 
             // success
-            first_new_keylist->keylist.push_back(first_new_key);
+            first_new_keylist->add(first_new_key);
             return true;
         }  // end if
     } // end for
@@ -570,7 +565,8 @@ bool Keys::doAction(int type, unsigned int mods, unsigned int key,
     if (!next_key)
         next_key = m_keylist;
 
-    mods = FbTk::KeyUtil::instance().cleanMods(mods);
+    FbTk::KeyUtil &keyutil = FbTk::KeyUtil::instance();
+    mods = keyutil.isolateModifierMask(keyutil.cleanMods(mods));
     RefKey temp_key = next_key->find(type, mods, key, context, isdouble);
 
     // just because we double-clicked doesn't mean we shouldn't look for single
@@ -624,13 +620,16 @@ bool Keys::doAction(int type, unsigned int mods, unsigned int key,
 void Keys::registerWindow(Window win, FbTk::EventHandler &h, int context) {
     m_window_map[win] = context;
     m_handler_map[win] = &h;
-    grabWindow(win);
+    h.grabButtons();
+    wantGrabs(win, context);
+    commitGrabs();
 }
 
 /// remove the window from the window map, probably being deleted
 void Keys::unregisterWindow(Window win) {
     FbTk::KeyUtil::ungrabKeys(win);
     FbTk::KeyUtil::ungrabButtons(win);
+    m_grabs.forget(win);
     m_handler_map.erase(win);
     m_window_map.erase(win);
 }
@@ -658,29 +657,26 @@ void Keys::keyMode(const string& keyMode) {
 }
 
 void Keys::setKeyMode(const FbTk::RefCount<t_key> &keyMode) {
-    ungrabKeys();
-    ungrabButtons();
-
-    // notify handlers that their buttons have been ungrabbed
-    HandlerMap::iterator h_it = m_handler_map.begin(),
-                         h_it_end  = m_handler_map.end();
-    for (; h_it != h_it_end; ++h_it)
-        h_it->second->grabButtons();
 
     t_key::keylist_t::iterator it = keyMode->keylist.begin();
     t_key::keylist_t::iterator it_end = keyMode->keylist.end();
     for (; it != it_end; ++it) {
         RefKey t = *it;
-        if (t->type == KeyPress) {
-            if (!t->key_str.empty()) {
-                int key = FbTk::KeyUtil::getKey(t->key_str.c_str());
-                t->key = key;
-            }
-            grabKey(t->key, t->mod);
-        } else {
-            grabButton(t->key, t->mod, t->context);
+        if (t->type == KeyPress && !t->key_str.empty()) {
+            int key = FbTk::KeyUtil::getKey(t->key_str.c_str());
+            if (t->key != static_cast<unsigned int>(key))
+                keyMode->indexed = false; // the keyboard mapping changed
+            t->key = key;
         }
     }
     m_keylist = keyMode;
+
+    // only what differs from the grabs of the last mode goes to the server
+    m_grabs.clearWanted();
+    WindowMap::iterator win_it = m_window_map.begin();
+    WindowMap::iterator win_it_end = m_window_map.end();
+    for (; win_it != win_it_end; ++win_it)
+        wantGrabs(win_it->first, win_it->second);
+    commitGrabs();
 }
 
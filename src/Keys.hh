@@ -24,6 +24,7 @@
 
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/RefCount.hh"
+#include "FbTk/GrabSet.hh"
 
 #include <X11/Xlib.h>
 #include <string>
@@ -105,11 +106,12 @@ private:
 
     void deleteTree();
 
-    void grabKey(unsigned int key, unsigned int mod);
     void ungrabKeys();
-    void grabButton(unsigned int button, unsigned int mod, int context);
     void ungrabButtons();
-    void grabWindow(Window win);
+    /// collects the grabs the current key mode needs on the window
+    void wantGrabs(Window win, int context);
+    /// sends what changed in the wanted grabs to the server
+    void commitGrabs();
 
     // Load default keybindings for when there are errors loading the keys file
     void loadDefaults();
@@ -127,6 +129,7 @@ private:
 
     WindowMap m_window_map;
     HandlerMap m_handler_map;
+    FbTk::GrabSet m_grabs;
 };
 
 #endif // KEYS_HH
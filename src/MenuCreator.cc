@@ -75,6 +75,17 @@ FbTk::StringConvertor s_stringconvertor(FbTk::StringConvertor::ToFbString);
 list<string> s_encoding_stack;
 list<size_t> s_stacksize_stack;
 
+/// where a [submenu] is in its file, to find it again after the file changed
+struct SubmenuPath {
+    bool begin; ///< the file starts with a [begin]
+    /// for each level, how many [submenu]s come before it in its parent
+    vector<int> ordinals;
+    list<string> encodings; ///< in effect at the top of the file
+};
+
+/// the menu body that is read, with the count of [submenu]s so far last
+SubmenuPath s_submenu_path;
+
 
 
 enum {
@@ -145,6 +156,21 @@ void startEncoding(const string &encoding) {
     s_stringconvertor.setSource(encoding);
 }
 
+/**
+ * Make the last valid encoding on the stack active.
+ */
+void useEncodings() {
+    s_stringconvertor.reset();
+
+    list<string>::reverse_iterator it = s_encoding_stack.rbegin();
+    list<string>::reverse_iterator it_end = s_encoding_stack.rend();
+    while (it != it_end && !s_stringconvertor.setSource(*it))
+        ++it;
+
+    if (it == it_end)
+        s_stringconvertor.setSource("");
+}
+
 /**
  * Pop the encoding from the stack, unless we are at our stacksize limit.
  * Restore the previous (valid) encoding.
@@ -158,15 +184,7 @@ void endEncoding() {
     }
 
     s_encoding_stack.pop_back();
-    s_stringconvertor.reset();
-
-    list<string>::reverse_iterator it = s_encoding_stack.rbegin();
-    list<string>::reverse_iterator it_end = s_encoding_stack.rend();
-    while (it != it_end && !s_stringconvertor.setSource(*it))
-        ++it;
-
-    if (it == it_end)
-        s_stringconvertor.setSource("");
+    useEncodings();
 }
 
 
@@ -311,24 +329,151 @@ public:
 
 };
 
-void translateMenuItem(FbTk::Parser &parse, ParseItem &item,
+void translateMenuItem(FbMenuParser &parse, ParseItem &item,
                        FbTk::StringConvertor &labelconvertor,
                        AutoReloadHelper *reloader);
 
+void parseMenu(FbMenuParser &pars, FbTk::Menu &menu,
+               FbTk::StringConvertor &label_convertor,
+               AutoReloadHelper *reloader);
+
+/**
+ * Moves the parser past the [end] of the submenu it's in, keeping track
+ * of the [encoding] tags on the way like parseMenu() would. Nothing is
+ * recoded or created.
+ */
+void skipMenu(FbMenuParser &parser) {
+    FbTk::Parser::Item key, label, cmd, icon;
+    int depth = 0;
+    while (!parser.eof()) {
+        parser>>key>>label>>cmd>>icon;
+        if (key.second == "submenu")
+            ++depth;
+        else if (key.second == "end" && depth-- == 0)
+            return;
+        else if (key.second == "encoding")
+            startEncoding(cmd.second);
+        else if (key.second == "endencoding")
+            endEncoding();
+    }
+}
+
+/**
+ * Moves the parser to the body of the [submenu] at path in the file as it
+ * reads now, keeping track of the [encoding] tags on the way.
+ * @return false if the file has no such submenu anymore
+ */
+bool findSubmenu(FbMenuParser &parser, const SubmenuPath &path) {
+    FbTk::Parser::Item key, label, cmd, icon;
+    if (path.begin) {
+        do {
+            if (parser.eof())
+                return false;
+            parser>>key>>label>>cmd>>icon;
+        } while (key.second != "begin");
+    }
+
+    for (size_t level = 0; level < path.ordinals.size(); ++level) {
+        for (int before = path.ordinals[level]; ; ) {
+            if (parser.eof())
+                return false;
+            parser>>key>>label>>cmd>>icon;
+            if (key.second == "end")
+                return false;
+            else if (key.second == "encoding")
+                startEncoding(cmd.second);
+            else if (key.second == "endencoding")
+                endEncoding();
+            else if (key.second == "submenu" && before-- == 0)
+                break;
+            else if (key.second == "submenu")
+                skipMenu(parser);
+        }
+    }
+    return true;
+}
+
+/**
+ * A [submenu] that is read from its file the first time it's opened.
+ *
+ * Only where its body starts in the file and the encodings in effect
+ * there are kept, so menus with thousands of entries cost next to nothing
+ * until they're looked at. If the file changed since, the body is looked
+ * up again from the top of the file by its SubmenuPath.
+ */
+class DeferredMenu: public FbMenu {
+public:
+    DeferredMenu(BScreen &screen, const FbMenuParser &parser,
+                 AutoReloadHelper *reloader):
+        FbMenu(screen.menuTheme(), screen.imageControl(),
+               *screen.layerManager().getLayer(ResourceLayer::MENU)),
+        m_filename(parser.filename()), m_mtime(parser.mtime()),
+        m_size(parser.size()), m_position(parser.position()),
+        m_row(parser.row()), m_path(s_submenu_path),
+        m_encodings(s_encoding_stack), m_reloader(reloader),
+        m_populated(false) { }
+
+    void populate() {
+        if (m_populated)
+            return;
+        m_populated = true;
 
-void parseMenu(FbTk::Parser &pars, FbTk::Menu &menu,
+        FbMenuParser parser(m_filename);
+        if (!parser.isLoaded())
+            return;
+
+        bool same_file = parser.mtime() == m_mtime && parser.size() == m_size;
+
+        // the menu may be opened while another one is read
+        list<string> encodings(same_file ? m_encodings : m_path.encodings);
+        list<size_t> stacksizes(1, encodings.size());
+        SubmenuPath path(m_path);
+        encodings.swap(s_encoding_stack);
+        stacksizes.swap(s_stacksize_stack);
+        std::swap(path, s_submenu_path);
+        useEncodings();
+
+        if (same_file ? parser.seek(m_position, m_row)
+                      : findSubmenu(parser, s_submenu_path))
+            parseMenu(parser, *this, s_stringconvertor, m_reloader);
+        endFile();
+
+        encodings.swap(s_encoding_stack);
+        stacksizes.swap(s_stacksize_stack);
+        std::swap(path, s_submenu_path);
+        useEncodings();
+
+        updateMenu();
+    }
+
+private:
+    string m_filename;
+    time_t m_mtime; ///< the file is read as it was then,
+    off_t m_size;   ///< and with this size
+    std::streampos m_position;
+    int m_row;
+    SubmenuPath m_path;
+    list<string> m_encodings;
+    AutoReloadHelper *m_reloader; ///< belongs to the top menu, which outlives us
+    bool m_populated;
+};
+
+
+void parseMenu(FbMenuParser &pars, FbTk::Menu &menu,
                FbTk::StringConvertor &label_convertor,
                AutoReloadHelper *reloader) {
     ParseItem pitem(&menu);
+    s_submenu_path.ordinals.push_back(0);
     while (!pars.eof()) {
         pitem.load(pars, label_convertor);
         if (pitem.key() == "end")
-            return;
+            break;
         translateMenuItem(pars, pitem, label_convertor, reloader);
     }
+    s_submenu_path.ordinals.pop_back();
 }
 
-void translateMenuItem(FbTk::Parser &parse, ParseItem &pitem,
+void translateMenuItem(FbMenuParser &parse, ParseItem &pitem,
                        FbTk::StringConvertor &labelconvertor,
                        AutoReloadHelper *reloader) {
     if (pitem.menu() == 0)
@@ -407,17 +552,19 @@ void translateMenuItem(FbTk::Parser &parse, ParseItem &pitem,
     } // end of include
     else if (str_key == "submenu") {
 
-        FbTk::Menu *submenu = MenuCreator::createMenu("", screen_number);
-        if (submenu == 0)
+        BScreen *screen = Fluxbox::instance()->findScreen(screen_number);
+        if (screen == 0)
             return;
 
+        // the body is read when the submenu is first opened
+        FbTk::Menu *submenu = new DeferredMenu(*screen, parse, reloader);
+        ++s_submenu_path.ordinals.back();
         if (!str_cmd.empty())
             submenu->setLabel(str_cmd);
         else
             submenu->setLabel(str_label);
 
-        parseMenu(parse, *submenu, labelconvertor, reloader);
-        submenu->updateMenu();
+        skipMenu(parse);
         menu.insertSubmenu(str_label, submenu);
 
     } // end of submenu
@@ -531,7 +678,10 @@ bool MenuCreator::createFromFile(const string &filename,
     if (reloader)
         reloader->addFile(real_filename);
 
+    SubmenuPath path = { begin, vector<int>(), s_encoding_stack };
+    std::swap(path, s_submenu_path);
     parseMenu(parser, inject_into, s_stringconvertor, reloader);
+    std::swap(path, s_submenu_path);
     endFile();
 
     return true;
@@ -0,0 +1,339 @@
+// MinOverlap.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "MinOverlap.hh"
+
+#include <algorithm>
+
+using std::vector;
+
+namespace {
+
+using MinOverlap::Frame;
+
+enum Corner {
+    TOPLEFT,
+    TOPRIGHT,
+    BOTTOMLEFT,
+    BOTTOMRIGHT
+};
+
+struct Candidate {
+    Corner corner; // the corner of the window pushed against the edges
+    int x, y;      // position of the top left corner of the window
+};
+
+class CandidateOrder {
+public:
+    CandidateOrder(MinOverlap::Order order, bool right_to_left, bool bottom_to_top):
+        m_order(order), m_right_to_left(right_to_left),
+        m_bottom_to_top(bottom_to_top) { }
+
+    bool operator()(const Candidate &a, const Candidate &b) const {
+        if (m_order == MinOverlap::ROWS) {
+            // if we're making rows, y-value is most important
+            if (a.y != b.y)
+                return ((a.y < b.y) ^ m_bottom_to_top);
+            if (a.x != b.x)
+                return ((a.x < b.x) ^ m_right_to_left);
+        } else {
+            // if we're making columns, x-value is most important
+            if (a.x != b.x)
+                return ((a.x < b.x) ^ m_right_to_left);
+            if (a.y != b.y)
+                return ((a.y < b.y) ^ m_bottom_to_top);
+        }
+        return (a.corner < b.corner);
+    }
+
+private:
+    MinOverlap::Order m_order;
+    bool m_right_to_left, m_bottom_to_top;
+};
+
+size_t indexOf(const vector<int> &values, int v) {
+    return std::lower_bound(values.begin(), values.end(), v) - values.begin();
+}
+
+void sortUnique(vector<int> &values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/// set of taken (column, row) cells, with the lowest taken cell per row and column
+class Grid {
+public:
+    Grid(size_t cols, size_t rows):
+        m_cols(cols), m_taken(cols * rows, 0),
+        m_row_min(rows, cols), m_col_min(cols, rows) { }
+
+    void take(size_t col, size_t row) {
+        m_taken[row * m_cols + col] = 1;
+        m_row_min[row] = std::min(m_row_min[row], col);
+        m_col_min[col] = std::min(m_col_min[col], row);
+    }
+
+    bool taken(size_t col, size_t row) const { return m_taken[row * m_cols + col] != 0; }
+    size_t rowMin(size_t row) const { return m_row_min[row]; }
+    size_t colMin(size_t col) const { return m_col_min[col]; }
+
+private:
+    size_t m_cols;
+    vector<char> m_taken;
+    vector<size_t> m_row_min, m_col_min;
+};
+
+/*
+ * Collects the candidates for one corner of the window.
+ *
+ * The coordinates are mirrored so every corner behaves like the top left
+ * one: a candidate (a, b) is blocked by a frame whose far edges (r, b')
+ * lie beyond it, and the frame then yields the candidates (a, b') and
+ * (r, b). Candidates a frame yields are never blocked by that same frame,
+ * so each frame only has to look at the candidates that existed before
+ * it. Only the order of the coordinates matters for blocking, so they are
+ * kept as indices into the sorted edges, and the lowest taken index of
+ * every row and column answers "is anything here blocked" at once.
+ */
+void addCandidates(Corner corner, const vector<Frame> &frames,
+                   int head_left, int head_top, int head_right, int head_bottom,
+                   int width, int height, vector<Candidate> &result) {
+
+    const bool right = (corner == TOPRIGHT || corner == BOTTOMRIGHT);
+    const bool bottom = (corner == BOTTOMLEFT || corner == BOTTOMRIGHT);
+
+    vector<int> cols(1, right ? -head_right : head_left);
+    vector<int> rows(1, bottom ? -head_bottom : head_top);
+    vector<Frame>::const_iterator it = frames.begin();
+    for (; it != frames.end(); ++it) {
+        if (!it->edges)
+            continue;
+        cols.push_back(right ? -it->left : it->right);
+        rows.push_back(bottom ? -it->top : it->bottom);
+    }
+    sortUnique(cols);
+    sortUnique(rows);
+
+    Grid grid(cols.size(), rows.size());
+    grid.take(indexOf(cols, right ? -head_right : head_left),
+              indexOf(rows, bottom ? -head_bottom : head_top));
+
+    vector<size_t> blocked_cols, blocked_rows;
+    for (it = frames.begin(); it != frames.end(); ++it) {
+        if (!it->edges)
+            continue;
+
+        const size_t col = indexOf(cols, right ? -it->left : it->right);
+        const size_t row = indexOf(rows, bottom ? -it->top : it->bottom);
+        const bool fits_col = right ? it->left - width >= head_left
+                                    : it->right + width <= head_right;
+        const bool fits_row = bottom ? it->top - height >= head_top
+                                     : it->bottom + height <= head_bottom;
+
+        blocked_cols.clear();
+        blocked_rows.clear();
+        for (size_t c = 0; c < col; ++c) {
+            if (grid.colMin(c) < row)
+                blocked_cols.push_back(c);
+        }
+        for (size_t r = 0; r < row; ++r) {
+            if (grid.rowMin(r) < col)
+                blocked_rows.push_back(r);
+        }
+
+        if (fits_row) {
+            for (size_t i = 0; i < blocked_cols.size(); ++i)
+                grid.take(blocked_cols[i], row);
+        }
+        if (fits_col) {
+            for (size_t i = 0; i < blocked_rows.size(); ++i)
+                grid.take(col, blocked_rows[i]);
+        }
+    }
+
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (grid.rowMin(r) == cols.size())
+            continue;
+        for (size_t c = grid.rowMin(r); c < cols.size(); ++c) {
+            if (!grid.taken(c, r))
+                continue;
+            Candidate cand;
+            cand.corner = corner;
+            cand.x = right ? -cols[c] - width : cols[c];
+            cand.y = bottom ? -rows[r] - height : rows[r];
+            result.push_back(cand);
+        }
+    }
+}
+
+/// prefix sums over a fixed number of slots (a Fenwick tree)
+class SumTree {
+public:
+    explicit SumTree(size_t size): m_sums(size + 1, 0) { }
+
+    void add(size_t slot, long long value) {
+        for (++slot; slot < m_sums.size(); slot += slot & (~slot + 1))
+            m_sums[slot] += value;
+    }
+
+    /// sum of the first @a count slots
+    long long sum(size_t count) const {
+        long long s = 0;
+        for (; count > 0; count -= count & (~count + 1))
+            s += m_sums[count];
+        return s;
+    }
+
+private:
+    vector<long long> m_sums;
+};
+
+struct Edge {
+    int y;
+    int sign;
+    size_t frame;
+
+    bool operator <(const Edge &o) const { return y < o.y; }
+};
+
+struct Probe {
+    int x, y;
+    int sign;
+    size_t candidate;
+
+    bool operator <(const Probe &o) const { return y < o.y; }
+};
+
+/*
+ * Total overlap of every candidate with all frames.
+ *
+ * With F(X, Y) the frame area left of X and above Y, the overlap of a
+ * rectangle is F at its bottom right and top left corners minus F at the
+ * other two. F is evaluated at all corners in one sweep down the screen:
+ * once Y passes a frame's top edge, it adds (Y - top) * w(X), and once Y
+ * passes its bottom edge, it takes (Y - bottom) * w(X) off again, where
+ * w(X) = (X - left)+ - (X - right)+ is the frame's width left of X.
+ * The coefficients of these piecewise linear terms are kept in prefix
+ * sums over the vertical frame edges.
+ */
+void computeOverlaps(const vector<Frame> &frames, const vector<Candidate> &candidates,
+                     int width, int height, vector<long long> &overlaps) {
+
+    vector<int> xs;
+    vector<Edge> edges;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const Frame &f = frames[i];
+        if (f.right <= f.left || f.bottom <= f.top)
+            continue; // covers nothing
+        xs.push_back(f.left);
+        xs.push_back(f.right);
+        Edge top = { f.top, 1, i };
+        Edge bottom = { f.bottom, -1, i };
+        edges.push_back(top);
+        edges.push_back(bottom);
+    }
+    sortUnique(xs);
+    std::sort(edges.begin(), edges.end());
+
+    vector<Probe> corners;
+    corners.reserve(candidates.size() * 4);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const Candidate &c = candidates[i];
+        Probe tl = { c.x, c.y, 1, i };
+        Probe tr = { c.x + width, c.y, -1, i };
+        Probe bl = { c.x, c.y + height, -1, i };
+        Probe br = { c.x + width, c.y + height, 1, i };
+        corners.push_back(tl);
+        corners.push_back(tr);
+        corners.push_back(bl);
+        corners.push_back(br);
+    }
+    std::sort(corners.begin(), corners.end());
+
+    // sum of c and c * x for the linear term, and the same scaled by the
+    // edge y for the constant term
+    SumTree lin(xs.size()), lin_x(xs.size()), con(xs.size()), con_x(xs.size());
+
+    vector<Edge>::const_iterator edge = edges.begin();
+    vector<Probe>::const_iterator it = corners.begin();
+    for (; it != corners.end(); ++it) {
+
+        for (; edge != edges.end() && edge->y < it->y; ++edge) {
+            const Frame &f = frames[edge->frame];
+            const long long y = edge->y;
+            const size_t left = indexOf(xs, f.left), right = indexOf(xs, f.right);
+            lin.add(left, edge->sign);
+            lin_x.add(left, edge->sign * static_cast<long long>(f.left));
+            con.add(left, edge->sign * y);
+            con_x.add(left, edge->sign * y * f.left);
+            lin.add(right, -edge->sign);
+            lin_x.add(right, -edge->sign * static_cast<long long>(f.right));
+            con.add(right, -edge->sign * y);
+            con_x.add(right, -edge->sign * y * f.right);
+        }
+
+        const size_t count = indexOf(xs, it->x);
+        const long long x = it->x, y = it->y;
+        const long long area = y * (x * lin.sum(count) - lin_x.sum(count))
+                                 - (x * con.sum(count) - con_x.sum(count));
+        overlaps[it->candidate] += it->sign * area;
+    }
+}
+
+} // end of anonymous namespace
+
+namespace MinOverlap {
+
+void findPosition(const vector<Frame> &frames,
+                  Order order, bool right_to_left, bool bottom_to_top,
+                  int head_left, int head_top, int head_right, int head_bottom,
+                  int width, int height, int &x, int &y) {
+
+    vector<Candidate> candidates;
+    addCandidates(TOPLEFT, frames, head_left, head_top, head_right, head_bottom,
+                  width, height, candidates);
+    addCandidates(TOPRIGHT, frames, head_left, head_top, head_right, head_bottom,
+                  width, height, candidates);
+    addCandidates(BOTTOMLEFT, frames, head_left, head_top, head_right, head_bottom,
+                  width, height, candidates);
+    addCandidates(BOTTOMRIGHT, frames, head_left, head_top, head_right, head_bottom,
+                  width, height, candidates);
+
+    std::sort(candidates.begin(), candidates.end(),
+              CandidateOrder(order, right_to_left, bottom_to_top));
+
+    // a window without area can't overlap anything
+    vector<long long> overlaps(candidates.size(), 0);
+    if (width > 0 && height > 0)
+        computeOverlaps(frames, candidates, width, height, overlaps);
+
+    // the first candidate with the least overlap wins
+    size_t best = 0;
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        if (overlaps[i] < overlaps[best])
+            best = i;
+    }
+
+    x = candidates[best].x;
+    y = candidates[best].y;
+}
+
+} // end namespace MinOverlap
@@ -0,0 +1,60 @@
+// MinOverlap.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef MINOVERLAP_HH
+#define MINOVERLAP_HH
+
+#include <vector>
+
+/**
+ * The search behind MinOverlapPlacement, kept free of X so it can be
+ * tested and benchmarked on its own.
+ *
+ * Candidate positions are the head corners and every position reachable
+ * by pushing a window corner against the edges of the existing windows.
+ * Among those, the first one (in row or column order) with the smallest
+ * total overlap wins.
+ */
+namespace MinOverlap {
+
+/// a window already on the head, in frame coordinates (right/bottom exclusive)
+struct Frame {
+    int left, top, right, bottom;
+    bool edges; ///< whether this window's edges produce candidate positions
+};
+
+enum Order {
+    ROWS,    ///< candidates sorted by y first
+    COLUMNS  ///< candidates sorted by x first
+};
+
+/**
+ * Finds the top left position for a width x height window.
+ * @param frames windows on the head, in the order their edges are visited
+ */
+void findPosition(const std::vector<Frame> &frames,
+                  Order order, bool right_to_left, bool bottom_to_top,
+                  int head_left, int head_top, int head_right, int head_bottom,
+                  int width, int height, int &x, int &y);
+
+} // end namespace MinOverlap
+
+#endif // MINOVERLAP_HH
@@ -47,6 +47,8 @@
 
 #include <cstring>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 
 using std::cerr;
@@ -662,6 +664,79 @@ Application* findMatchingPatterns(ClientPattern *pat, Remember::Patterns *patlis
 
 } // end anonymous namespace
 
+/*
+  Most apps entries match on a literal name, class or role. The index
+  keeps those entries in hash tables by that value, so a new client is
+  only checked against the entries that can match it and the ones that
+  don't have a literal term.
+*/
+class Remember::PatternIndex {
+public:
+    explicit PatternIndex(Patterns &pats);
+
+    /// the entries the client might match, in the order of the apps file
+    void candidates(const WinClient &client, std::vector<Patterns::iterator> &result) const;
+
+private:
+    typedef std::vector<size_t> Positions;
+    typedef std::unordered_map<string, Positions> Buckets;
+
+    static const ClientPattern::WinProperty s_props[3];
+
+    std::vector<Patterns::iterator> m_entries;
+    Buckets m_buckets[3]; ///< for each of s_props
+    Positions m_fallback; ///< entries without literal term
+};
+
+const ClientPattern::WinProperty Remember::PatternIndex::s_props[3] = {
+    ClientPattern::NAME, ClientPattern::CLASS, ClientPattern::ROLE
+};
+
+Remember::PatternIndex::PatternIndex(Patterns &pats) {
+    ClientPattern::WinProperty prop;
+    string value;
+    for (Patterns::iterator it = pats.begin(); it != pats.end(); ++it) {
+        size_t pos = m_entries.size();
+        m_entries.push_back(it);
+        if (!it->first->literalTerm(prop, value)) {
+            m_fallback.push_back(pos);
+            continue;
+        }
+        for (int i = 0; i < 3; ++i) {
+            if (s_props[i] == prop)
+                m_buckets[i][value].push_back(pos);
+        }
+    }
+}
+
+void Remember::PatternIndex::candidates(const WinClient &client,
+                                        std::vector<Patterns::iterator> &result) const {
+    result.clear();
+
+    // every entry is in exactly one of these, each sorted by position
+    const Positions *lists[4] = { &m_fallback, 0, 0, 0 };
+    size_t next[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 3; ++i) {
+        if (m_buckets[i].empty())
+            continue;
+        Buckets::const_iterator it = m_buckets[i].find(ClientPattern::getProperty(s_props[i], client));
+        if (it != m_buckets[i].end())
+            lists[i + 1] = &it->second;
+    }
+
+    while (true) {
+        int first = -1;
+        for (int i = 0; i < 4; ++i) {
+            if (lists[i] && next[i] < lists[i]->size() &&
+                (first < 0 || (*lists[i])[next[i]] < (*lists[first])[next[first]]))
+                first = i;
+        }
+        if (first < 0)
+            break;
+        result.push_back(m_entries[(*lists[first])[next[first]++]]);
+    }
+}
+
 /*------------------------------------------------------------------*\
 \*------------------------------------------------------------------*/
 
@@ -715,14 +790,20 @@ Application* Remember::find(WinClient &winclient) {
     if (wc_it != m_clients.end())
         return wc_it->second;
     else {
-        Patterns::iterator it = m_pats->begin();
-        for (; it != m_pats->end(); ++it)
+        if (!m_index)
+            m_index.reset(new PatternIndex(*m_pats));
+
+        std::vector<Patterns::iterator> candidates;
+        m_index->candidates(winclient, candidates);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            Patterns::iterator it = candidates[i];
             if (it->first->match(winclient) &&
                 it->second->is_transient == winclient.isTransient()) {
                 it->first->addMatch();
                 m_clients[&winclient] = it->second;
                 return it->second;
             }
+        }
     }
     // oh well, no matches
     return 0;
@@ -744,6 +825,7 @@ Application * Remember::add(WinClient &winclient) {
     m_clients[&winclient] = app;
     p->addMatch();
     m_pats->push_back(make_pair(p, app));
+    m_index.reset();
     return app;
 }
 
@@ -772,6 +854,7 @@ void Remember::reload() {
     Patterns *old_pats = m_pats.release();
     set<Application *> reused_apps;
     m_pats.reset(new Patterns());
+    m_index.reset();
     m_startups.clear();
 
     if (apps_file.fail()) {
@@ -154,8 +154,11 @@ public:
     static Remember &instance() { return *s_instance; }
 
 private:
+    class PatternIndex;
 
     std::unique_ptr<Patterns> m_pats;
+    /// built on demand, reset whenever m_pats changes
+    std::unique_ptr<PatternIndex> m_index;
     Clients m_clients;
 
     Startups m_startups;
@@ -49,6 +49,7 @@
 #include "HeadArea.hh"
 #include "RectangleUtil.hh"
 #include "FbCommands.hh"
+#include "StartupProfile.hh"
 #ifdef USE_SYSTRAY
 #include "SystemTray.hh"
 #endif
@@ -70,6 +71,7 @@
 #include "FbTk/STLUtil.hh"
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/Util.hh"
+#include "FbTk/FbTime.hh"
 
 #ifdef USE_SLIT
 #include "Slit.hh"
@@ -233,6 +235,7 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_head_areas[0] = new HeadArea();
 
     initXinerama();
+    updateRefreshRate();
 
     // setup error handler to catch "screen already managed by other wm"
     XErrorHandler old = XSetErrorHandler((XErrorHandler) anotherWMRunning);
@@ -331,6 +334,14 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_tracker.join(focusedWinFrameTheme()->reconfigSig(),
             FbTk::MemFun(*this, &BScreen::focusedWinFrameThemeReconfigured));
 
+    // a single raise restacks several times, tell the others once
+    m_stacking_timer.setTimeout(0);
+    m_stacking_timer.fireOnce(true);
+    FbTk::RefCount<FbTk::Command<void> > stacking_cmd(new FbTk::SimpleCommand<BScreen>(*this, &BScreen::emitClientStacking));
+    m_stacking_timer.setCommand(stacking_cmd);
+    m_tracker.join(m_layermanager.stackingSig(),
+            FbTk::MemFunIgnoreArgs(*this, &BScreen::stackingChanged));
+
 
     renderGeomWindow();
     renderPosWindow();
@@ -370,12 +381,14 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     }
 
     changeWorkspaceID(first_desktop);
+    StartupProfile::mark("setup", screenNumber());
 
 #ifdef USE_SLIT
     if (opts & Fluxbox::OPT_SLIT) {
         Slit* slit = new Slit(*this, *layerManager().getLayer(ResourceLayer::DESKTOP), fluxbox->getSlitlistFilename().c_str());
         m_slit.reset(slit);
     }
+    StartupProfile::mark("slit", screenNumber());
 #endif // USE_SLIT
 
     rm.unlock();
@@ -458,6 +471,7 @@ void BScreen::initWindows() {
         Toolbar* tb = new Toolbar(*this, *layerManager().getLayer(::ResourceLayer::NORMAL));
         m_toolbar.reset(tb);
     }
+    StartupProfile::mark("toolbar", screenNumber());
 #endif // USE_TOOLBAR
 
     unsigned int nchild;
@@ -556,6 +570,7 @@ void BScreen::initWindows() {
         slit()->show();
 #endif // USE_SLIT
 
+    StartupProfile::mark("windows", screenNumber());
 }
 
 unsigned int BScreen::currentWorkspaceID() const {
@@ -609,6 +624,14 @@ unsigned int BScreen::maxBottom(int head) const {
         return doFullMax() ? height() : height() - availableWorkspaceArea(head)->bottom();
 }
 
+void BScreen::stackingChanged() {
+    m_stacking_timer.start();
+}
+
+void BScreen::emitClientStacking() {
+    m_clientstacking_sig.emit(*this);
+}
+
 void BScreen::focusedWinFrameThemeReconfigured() {
     renderGeomWindow();
     renderPosWindow();
@@ -975,17 +998,11 @@ void BScreen::changeWorkspaceID(unsigned int id, bool revert) {
     Workspace *old = currentWorkspace();
     m_current_workspace = getWorkspace(id);
 
-    // we show new workspace first in order to appear faster
+    // the whole switch goes out in one burst: we show the new workspace
+    // first in order to appear faster, the stuck windows just change
+    // lists without being unmapped, and everything left gets hidden
     currentWorkspace()->showAll();
-
-    // reassociate all windows that are stuck to the new workspace
-    Workspace::Windows wins = old->windowList();
-    Workspace::Windows::iterator it = wins.begin();
-    for (; it != wins.end(); ++it) {
-        if ((*it)->isStuck()) {
-            reassociateWindow(*it, id, true);
-        }
-    }
+    old->moveStuckWindows(*currentWorkspace());
 
     // change workspace ID of stuck iconified windows, too
     Icons::iterator icon_it = iconList().begin();
@@ -1595,6 +1612,7 @@ void BScreen::renderPosWindow() {
 void BScreen::updateSize() {
     // update xinerama layout
     initXinerama();
+    updateRefreshRate();
 
     // check if window geometry has changed
     if (rootWindow().updateGeometry()) {
@@ -1710,6 +1728,58 @@ void BScreen::initXinerama() {
     reconfigureStruts();
 }
 
+void BScreen::updateRefreshRate() {
+
+    m_refresh_rate = 0;
+
+#ifdef HAVE_RANDR
+    Display* display = FbTk::App::instance()->display();
+    XRRScreenResources* res = XRRGetScreenResourcesCurrent(display, rootWindow().window());
+    if (!res)
+        return;
+
+    for (int i = 0; i < res->ncrtc; ++i) {
+        XRRCrtcInfo* crtc = XRRGetCrtcInfo(display, res, res->crtcs[i]);
+        if (!crtc)
+            continue;
+
+        for (int m = 0; crtc->mode != None && m < res->nmode; ++m) {
+            const XRRModeInfo& mode = res->modes[m];
+            if (mode.id != crtc->mode)
+                continue;
+
+            double vtotal = mode.vTotal;
+            if (mode.modeFlags & RR_DoubleScan)
+                vtotal *= 2;
+            if (mode.modeFlags & RR_Interlace)
+                vtotal /= 2;
+
+            if (mode.hTotal > 0 && vtotal > 0) {
+                int rate = static_cast<int>(mode.dotClock / (mode.hTotal * vtotal) + 0.5);
+                m_refresh_rate = std::max(m_refresh_rate, rate);
+            }
+            break;
+        }
+        XRRFreeCrtcInfo(crtc);
+    }
+    XRRFreeScreenResources(res);
+#endif // HAVE_RANDR
+
+    fbdbg<<"BScreen::updateRefreshRate(): "<<m_refresh_rate<<" Hz"<<endl;
+}
+
+uint64_t BScreen::opaqueMoveInterval() const {
+
+    // the user knows best, then the crtcs, then a sane default
+    int rate = *resource.opaque_move_rate;
+    if (rate <= 0)
+        rate = m_refresh_rate;
+    if (rate <= 0)
+        rate = 60;
+
+    return FbTk::FbTime::IN_SECONDS / rate;
+}
+
 /* Move windows out of inactive heads */
 void BScreen::clearHeads() {
     if (!hasXinerama()) return;
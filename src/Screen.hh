@@ -40,6 +40,7 @@
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/Signal.hh"
 #include "FbTk/RelCalcHelper.hh"
+#include "FbTk/Timer.hh"
 
 #include "FocusControl.hh"
 
@@ -100,6 +101,9 @@ public:
     bool doAutoRaise() const { return *resource.auto_raise; }
     bool clickRaises() const { return *resource.click_raises; }
     bool doOpaqueMove() const { return *resource.opaque_move; }
+    bool prerenderFrames() const { return *resource.prerender_frames; }
+    /// @return minimum time between two applied frame moves, in microseconds
+    uint64_t opaqueMoveInterval() const;
     bool doFullMax() const { return *resource.full_max; }
     bool getMaxIgnoreIncrement() const { return *resource.max_ignore_inc; }
     bool getMaxDisableMove() const { return *resource.max_disable_move; }
@@ -199,6 +203,8 @@ public:
     typedef FbTk::Signal<BScreen&> ScreenSignal;
     /// client list signal
     ScreenSignal &clientListSig() { return m_clientlist_sig; }
+    /// stacking order of the clients changed (emitted once per batch of changes)
+    ScreenSignal &clientStackingSig() { return m_clientstacking_sig; }
     /// icon list sig
     ScreenSignal &iconListSig() { return m_iconlist_sig; }
     /// workspace count signal
@@ -393,6 +399,8 @@ public:
 
     void initXinerama();
     void clearXinerama();
+    /// read the refresh rate of the fastest active crtc (RandR)
+    void updateRefreshRate();
     void clearHeads();
     /// clean up xinerama
 
@@ -477,6 +485,9 @@ private:
 
     const Strut* availableWorkspaceArea(int head) const;
 
+    void stackingChanged();
+    void emitClientStacking();
+
     FbTk::SignalTracker m_tracker;
     ScreenSignal m_reconfigure_sig; ///< reconfigure signal
 
@@ -485,12 +496,14 @@ private:
     ScreenSignal m_workspace_area_sig; ///< workspace area changed signal
     ScreenSignal m_iconlist_sig; ///< notify if a window gets iconified/deiconified
     ScreenSignal m_clientlist_sig;  ///< client signal
+    ScreenSignal m_clientstacking_sig; ///< client stacking order signal
     ScreenSignal m_bg_change_sig; ///< background change signal
     ScreenSignal m_workspacecount_sig; ///< workspace count signal
     ScreenSignal m_currentworkspace_sig; ///< current workspace signal
     ScreenSignal m_workspacenames_sig; ///< workspace names signal
 
     FbTk::MultLayers m_layermanager;
+    FbTk::Timer m_stacking_timer; ///< collects stacking changes into one signal
 
     bool root_colormap_installed;
 
@@ -556,6 +569,7 @@ private:
     } m_xinerama;
 
     std::vector<HeadArea*> m_head_areas;
+    int m_refresh_rate; ///< in Hz, 0 if unknown
     std::vector<Strut*> m_head_struts;
 
     struct {
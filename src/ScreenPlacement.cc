@@ -29,6 +29,7 @@
 
 #include "Screen.hh"
 #include "Window.hh"
+#include "Workspace.hh"
 
 #include "FbTk/Menu.hh"
 
@@ -57,6 +58,63 @@ ScreenPlacement::ScreenPlacement(BScreen &screen):
 {
 }
 
+void ScreenPlacement::findObstacles(const FluxboxWindow &win, int head, int layernum,
+                                    std::vector<FluxboxWindow *> &result) const {
+
+    const int x = static_cast<signed>(m_screen.maxLeft(head));
+    const int y = static_cast<signed>(m_screen.maxTop(head));
+    const int w = static_cast<signed>(m_screen.maxRight(head)) - x;
+    const int h = static_cast<signed>(m_screen.maxBottom(head)) - y;
+
+    const Workspace *space = m_screen.getWorkspace(win.workspaceNumber());
+    if (space)
+        space->findWindows(layernum, x, y, w, h, result);
+
+    // sticky windows are kept on the current workspace
+    const Workspace *current = m_screen.currentWorkspace();
+    if (current == 0 || current == space)
+        return;
+
+    std::vector<FluxboxWindow *> sticky;
+    current->findWindows(layernum, x, y, w, h, sticky);
+    for (size_t i = 0; i < sticky.size(); ++i) {
+        if (sticky[i]->isStuck())
+            result.push_back(sticky[i]);
+    }
+}
+
+void ScreenPlacement::findFreeSpace(const FluxboxWindow &win, int head,
+                                    FreeSpace &result) const {
+
+    const int x = static_cast<signed>(m_screen.maxLeft(head));
+    const int y = static_cast<signed>(m_screen.maxTop(head));
+    const int w = static_cast<signed>(m_screen.maxRight(head)) - x;
+    const int h = static_cast<signed>(m_screen.maxBottom(head)) - y;
+
+    Workspace *space = m_screen.getWorkspace(win.workspaceNumber());
+    if (space)
+        result = space->freeSpace(win.layerNum(), x, y, w, h, &win);
+    else
+        result.reset(x, y, w, h);
+
+    // sticky windows are kept on the current workspace
+    const Workspace *current = m_screen.currentWorkspace();
+    if (current == 0 || current == space)
+        return;
+
+    std::vector<FluxboxWindow *> sticky;
+    current->findWindows(win.layerNum(), x, y, w, h, sticky);
+    for (size_t i = 0; i < sticky.size(); ++i) {
+        const FluxboxWindow &other = *sticky[i];
+        if (!other.isStuck() || &other == &win)
+            continue;
+        const int bw = 2 * other.frame().window().borderWidth();
+        result.occupy(other.x() - other.xOffset(), other.y() - other.yOffset(),
+                      other.width() + bw + other.widthOffset(),
+                      other.height() + bw + other.heightOffset());
+    }
+}
+
 bool ScreenPlacement::placeWindow(const FluxboxWindow &win, int head,
                                   int &place_x, int &place_y) {
 
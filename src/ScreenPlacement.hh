@@ -26,11 +26,13 @@
 #include "FbTk/Resource.hh"
 
 #include <memory>
+#include <vector>
 
 namespace FbTk {
     class Menu;
 }
 class BScreen;
+class FreeSpace;
 
 /**
  * Main class for strategy handling
@@ -72,6 +74,21 @@ public:
     // places and show 'menu' at 'x','y'
     void placeAndShowMenu(FbTk::Menu& menu, int x, int y, bool respect_struts);
 
+    /**
+     * Collects the windows that a strategy has to consider when placing
+     * @a win on @a head: the ones on its workspace plus the sticky ones,
+     * in window list order.
+     * @param layernum only this layer, negative means all layers
+     */
+    void findObstacles(const FluxboxWindow &win, int head, int layernum,
+                       std::vector<FluxboxWindow *> &result) const;
+
+    /**
+     * Collects the free space in @a win's layer on @a head, leaving out
+     * @a win itself and taking the sticky windows into account.
+     */
+    void findFreeSpace(const FluxboxWindow &win, int head, FreeSpace &result) const;
+
     PlacementPolicy placementPolicy() const { return *m_placement_policy; }
     RowDirection rowDirection() const { return *m_row_direction; }
     ColumnDirection colDirection() const { return *m_col_direction; }
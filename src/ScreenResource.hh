@@ -40,7 +40,8 @@ struct ScreenResource {
        workspace_warping_vertical,
        show_window_pos,
        auto_raise,
-       click_raises;
+       click_raises,
+       prerender_frames;
 
     FbTk::Resource<std::string> default_deco;
     FbTk::Resource<FbWinFrame::TabPlacement> tab_placement;
@@ -55,6 +56,7 @@ struct ScreenResource {
         menu_delay,
         tab_width,
         tooltip_delay,
+        opaque_move_rate,
        workspace_warping_vertical_offset;
     FbTk::Resource<bool> allow_remote_actions;
     FbTk::Resource<bool> clientmenu_use_pixmap;
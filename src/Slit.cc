@@ -254,7 +254,7 @@ Slit::Slit(BScreen &scr, FbTk::Layer &layer, const char *filename)
     frame.window.setWindowRole("fluxbox-slit");
 
     // attach to theme and root window change signal
-    join(theme().reconfigSig(), FbTk::MemFun(*this, &Slit::reconfigure));
+    join(theme().reconfigSig(), FbTk::MemFun(*this, &Slit::themeReconfigured));
 
     join(scr.resizeSig(),
          FbTk::MemFun(*this, &Slit::screenSizeChanged));
@@ -567,6 +567,48 @@ void Slit::removeClient(Window w, bool remap) {
 }
 
 
+void Slit::themeReconfigured() {
+    if (!theme()->onlyColorsChanged()) {
+        reconfigure();
+        return;
+    }
+
+    frame.window.setBorderColor(theme()->borderColor());
+    renderBackground();
+    frame.window.clear();
+
+    // get the dockapps to update their backgrounds
+    SlitClients::iterator client_it = m_client_list.begin();
+    SlitClients::iterator client_it_end = m_client_list.end();
+    for (; client_it != client_it_end; ++client_it) {
+        if ((*client_it)->window() != None && (*client_it)->visible() &&
+            screen().isKdeDockapp((*client_it)->window())) {
+            (*client_it)->hide();
+            (*client_it)->show();
+        }
+    }
+}
+
+void Slit::renderBackground() {
+    Pixmap tmp = frame.pixmap;
+    FbTk::ImageControl &image_ctrl = screen().imageControl();
+    const FbTk::Texture &texture = m_slit_theme->texture();
+    if (!texture.usePixmap()) {
+        frame.pixmap = 0;
+        frame.window.setBackgroundColor(texture.color());
+    } else {
+        frame.pixmap = image_ctrl.renderImage(frame.width, frame.height,
+                                              texture);
+        if (frame.pixmap == 0)
+            frame.window.setBackgroundColor(texture.color());
+        else
+            frame.window.setBackgroundPixmap(frame.pixmap);
+    }
+
+    if (tmp)
+        image_ctrl.removeImage(tmp);
+}
+
 void Slit::reconfigure() {
 
     bool allow_autohide = true;
@@ -640,23 +682,7 @@ void Slit::reconfigure() {
     frame.window.setBorderWidth(theme()->borderWidth());
     frame.window.setBorderColor(theme()->borderColor());
 
-    Pixmap tmp = frame.pixmap;
-    FbTk::ImageControl &image_ctrl = screen().imageControl();
-    const FbTk::Texture &texture = m_slit_theme->texture();
-    if (!texture.usePixmap()) {
-        frame.pixmap = 0;
-        frame.window.setBackgroundColor(texture.color());
-    } else {
-        frame.pixmap = image_ctrl.renderImage(frame.width, frame.height,
-                                              texture);
-        if (frame.pixmap == 0)
-            frame.window.setBackgroundColor(texture.color());
-        else
-            frame.window.setBackgroundPixmap(frame.pixmap);
-    }
-
-    if (tmp)
-        image_ctrl.removeImage(tmp);
+    renderBackground();
 
     // could have changed types, so we must set both
     if (FbTk::Transparent::haveComposite()) {
@@ -959,7 +985,7 @@ void Slit::buttonPressEvent(XButtonEvent &be) {
     }
 
     if (be.button == 1)
-        frame.window.raise();
+        raise();
 
     if (be.button != Button3) {
         XAllowEvents(dpy, ReplayPointer, CurrentTime);
@@ -1070,6 +1096,10 @@ void Slit::clearWindow() {
     frame.window.clear();
 }
 
+void Slit::raise() {
+    m_layeritem->raise();
+}
+
 void Slit::toggleHidden() {
     m_hidden = ! m_hidden; // toggle hidden state
     if (isHidden())
@@ -102,6 +102,7 @@ public:
     //@}
 
     void moveToLayer(int layernum);
+    void raise();
     void toggleHidden();
     void toggleAboveDock();
 
@@ -136,6 +137,9 @@ private:
     void updateAlpha();
     void updateCrossingState();
     void clearWindow();
+    /// a new style only updates the colors if nothing else changed
+    void themeReconfigured();
+    void renderBackground();
     void setupMenu();
 
     void removeClient(SlitClient *client, bool remap, bool destroy);
@@ -36,6 +36,11 @@ SlitTheme::SlitTheme(int screen_num):FbTk::Theme(screen_num),
 }
 
 
+bool SlitTheme::onlyColorsChanged() const {
+    const FbTk::ThemeItem_base *colors[] = { &m_texture, &m_border_color };
+    return onlyChanged(colors, 2);
+}
+
 void SlitTheme::reconfigTheme() {
 }
 
@@ -38,6 +38,9 @@ public:
     int borderWidth() const { return *m_border_width; }
     int bevelWidth() const { return *m_bevel_width; }
 
+    /// @return true if the last load that changed the theme only changed colors
+    bool onlyColorsChanged() const;
+
     virtual FbTk::Signal<> &reconfigSig() { return FbTk::Theme::reconfigSig(); }
 
     virtual SlitTheme &operator *() { return *this; }
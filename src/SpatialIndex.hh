@@ -0,0 +1,179 @@
+// SpatialIndex.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef SPATIALINDEX_HH
+#define SPATIALINDEX_HH
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniform grid over rectangles.
+ *
+ * Every item is registered in each cell its rectangle touches, so a query
+ * only has to look at the items near the queried area instead of all of
+ * them. Rectangles are treated as closed: touching edges count as an
+ * intersection. Query results are returned sorted by the 'order' given on
+ * insertion, which lets callers keep the order of their own lists.
+ */
+template <typename T>
+class SpatialIndex {
+public:
+    explicit SpatialIndex(int cell_size = 256):
+        m_cell_size(cell_size > 0 ? cell_size : 256) { }
+
+    /// adds @a item or updates its rectangle and order if already known
+    void insert(const T &item, int x, int y, int width, int height,
+                unsigned long order) {
+
+        typename Items::iterator it = m_items.find(item);
+        if (it != m_items.end())
+            unlink(item, it->second);
+        else
+            it = m_items.insert(std::make_pair(item, Entry())).first;
+
+        Entry &e = it->second;
+        e.x = x;
+        e.y = y;
+        e.width = std::max(width, 0);
+        e.height = std::max(height, 0);
+        e.order = order;
+        e.cx0 = cell(x);
+        e.cy0 = cell(y);
+        e.cx1 = cell(x + e.width);
+        e.cy1 = cell(y + e.height);
+        link(item, e);
+    }
+
+    void remove(const T &item) {
+        typename Items::iterator it = m_items.find(item);
+        if (it == m_items.end())
+            return;
+        unlink(item, it->second);
+        m_items.erase(it);
+    }
+
+    bool contains(const T &item) const { return m_items.find(item) != m_items.end(); }
+    bool empty() const { return m_items.empty(); }
+    size_t size() const { return m_items.size(); }
+
+    void clear() {
+        m_items.clear();
+        m_cells.clear();
+    }
+
+    /// appends all items whose rectangles touch the given one to @a result
+    void query(int x, int y, int width, int height, std::vector<T> &result) const {
+
+        if (m_items.empty())
+            return;
+
+        width = std::max(width, 0);
+        height = std::max(height, 0);
+
+        const int cx0 = cell(x), cy0 = cell(y);
+        const int cx1 = cell(x + width), cy1 = cell(y + height);
+
+        std::vector<std::pair<unsigned long, T> > found;
+
+        // huge areas (eg. a half plane) are cheaper to answer by walking
+        // the occupied cells than by walking the (mostly empty) range
+        const long long range = static_cast<long long>(cx1 - cx0 + 1) *
+                                static_cast<long long>(cy1 - cy0 + 1);
+        if (range > static_cast<long long>(m_cells.size())) {
+            typename Cells::const_iterator c = m_cells.begin();
+            for (; c != m_cells.end(); ++c) {
+                if (c->first.first < cx0 || c->first.first > cx1 ||
+                    c->first.second < cy0 || c->first.second > cy1)
+                    continue;
+                collect(c->second, x, y, width, height, found);
+            }
+        } else {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                for (int cy = cy0; cy <= cy1; ++cy) {
+                    typename Cells::const_iterator c = m_cells.find(std::make_pair(cx, cy));
+                    if (c != m_cells.end())
+                        collect(c->second, x, y, width, height, found);
+                }
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+
+        for (size_t i = 0; i < found.size(); ++i)
+            result.push_back(found[i].second);
+    }
+
+private:
+    struct Entry {
+        int x, y, width, height;
+        int cx0, cy0, cx1, cy1; ///< range of cells the rectangle touches
+        unsigned long order;
+    };
+
+    typedef std::map<T, Entry> Items;
+    typedef std::vector<T> Cell;
+    typedef std::map<std::pair<int, int>, Cell> Cells;
+
+    /// cell of a coordinate, rounding towards negative infinity
+    int cell(int v) const {
+        return v >= 0 ? v / m_cell_size : -((-v - 1) / m_cell_size) - 1;
+    }
+
+    void link(const T &item, const Entry &e) {
+        for (int cx = e.cx0; cx <= e.cx1; ++cx)
+            for (int cy = e.cy0; cy <= e.cy1; ++cy)
+                m_cells[std::make_pair(cx, cy)].push_back(item);
+    }
+
+    void unlink(const T &item, const Entry &e) {
+        for (int cx = e.cx0; cx <= e.cx1; ++cx) {
+            for (int cy = e.cy0; cy <= e.cy1; ++cy) {
+                typename Cells::iterator c = m_cells.find(std::make_pair(cx, cy));
+                if (c == m_cells.end())
+                    continue;
+                c->second.erase(std::remove(c->second.begin(), c->second.end(), item),
+                                c->second.end());
+                if (c->second.empty())
+                    m_cells.erase(c);
+            }
+        }
+    }
+
+    void collect(const Cell &c, int x, int y, int width, int height,
+                 std::vector<std::pair<unsigned long, T> > &found) const {
+        for (size_t i = 0; i < c.size(); ++i) {
+            const Entry &e = m_items.find(c[i])->second;
+            if (e.x <= x + width && x <= e.x + e.width &&
+                e.y <= y + height && y <= e.y + e.height)
+                found.push_back(std::make_pair(e.order, c[i]));
+        }
+    }
+
+    int m_cell_size;
+    Items m_items;
+    Cells m_cells;
+};
+
+#endif // SPATIALINDEX_HH
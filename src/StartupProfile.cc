@@ -0,0 +1,137 @@
+// StartupProfile.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "StartupProfile.hh"
+
+#include "FbTk/FbTime.hh"
+#include "FbTk/I18n.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <unistd.h>
+
+using std::string;
+
+namespace {
+
+struct Phase {
+    string name;
+    uint64_t start, end;
+};
+
+bool s_enabled = false;
+string s_trace_file;
+uint64_t s_start = 0;
+std::vector<Phase> s_phases;
+
+string escape(const string &str) {
+    string result;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '"' || str[i] == '\\')
+            result += '\\';
+        result += str[i];
+    }
+    return result;
+}
+
+void writeTrace() {
+    std::ofstream trace(s_trace_file.c_str());
+    if (!trace) {
+        _FB_USES_NLS;
+        std::cerr << _FB_CONSOLETEXT(main, StartupTraceFailed,
+                                     "Failed to write the startup trace to",
+                                     "Error message, followed by the file name")
+                  << " " << s_trace_file << std::endl;
+        return;
+    }
+
+    const int pid = getpid();
+    trace << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < s_phases.size(); ++i) {
+        const Phase &phase = s_phases[i];
+        trace << (i ? ",\n" : "")
+              << "{\"name\":\"" << escape(phase.name) << "\",\"cat\":\"startup\","
+              << "\"ph\":\"X\",\"ts\":" << phase.start - s_start
+              << ",\"dur\":" << phase.end - phase.start
+              << ",\"pid\":" << pid << ",\"tid\":" << pid << "}";
+    }
+    trace << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+} // end of anonymous namespace
+
+namespace StartupProfile {
+
+void enable(const string &trace_file) {
+    s_enabled = true;
+    s_trace_file = trace_file;
+    s_start = FbTk::FbTime::mono();
+}
+
+bool enabled() {
+    return s_enabled;
+}
+
+void mark(const char *phase, int screen) {
+    if (!s_enabled)
+        return;
+
+    Phase p;
+    p.start = s_phases.empty() ? s_start : s_phases.back().end;
+    p.end = FbTk::FbTime::mono();
+    if (screen >= 0) {
+        char prefix[32];
+        sprintf(prefix, "screen %d ", screen);
+        p.name = prefix;
+    }
+    p.name += phase;
+    s_phases.push_back(p);
+}
+
+void finish() {
+    if (!s_enabled)
+        return;
+
+    mark("first idle");
+    s_enabled = false;
+
+    // through cout, which -log sends to the log file
+    const double total = s_phases.back().end - s_start;
+    char line[128];
+    std::cout << "Startup profile:" << std::endl;
+    for (size_t i = 0; i < s_phases.size(); ++i) {
+        const double duration = s_phases[i].end - s_phases[i].start;
+        snprintf(line, sizeof(line), "  %-24s %10.3f ms %6.1f%%", s_phases[i].name.c_str(),
+                 duration / 1000.0, total > 0 ? 100.0 * duration / total : 0.0);
+        std::cout << line << std::endl;
+    }
+    snprintf(line, sizeof(line), "  %-24s %10.3f ms", "total", total / 1000.0);
+    std::cout << line << std::endl;
+
+    if (!s_trace_file.empty())
+        writeTrace();
+    s_phases.clear();
+}
+
+} // end namespace StartupProfile
@@ -0,0 +1,48 @@
+// StartupProfile.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef STARTUPPROFILE_HH
+#define STARTUPPROFILE_HH
+
+#include <string>
+
+/**
+ * Times the phases of the startup, for -startup-profile.
+ *
+ * The phases follow each other: mark() ends the current one, the next
+ * starts there. finish() is called when fluxbox first runs out of
+ * events, it prints how long each phase took.
+ */
+namespace StartupProfile {
+
+/// starts the clock, and writes a Chrome trace to trace_file if it's set
+void enable(const std::string &trace_file);
+bool enabled();
+
+/// ends a phase, optionally one of a screen
+void mark(const char *phase, int screen = -1);
+
+/// ends the last phase, then prints the table and writes the trace
+void finish();
+
+} // end namespace StartupProfile
+
+#endif // STARTUPPROFILE_HH
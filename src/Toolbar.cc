@@ -224,7 +224,7 @@ Toolbar::Toolbar(BScreen &scrn, FbTk::Layer &layer, size_t width):
             FbTk::MemFunIgnoreArgs(*this, &Toolbar::reconfigure));
 
     // we need to get notified when the theme is reloaded
-    m_signal_tracker.join(m_theme.reconfigSig(), FbTk::MemFun(*this, &Toolbar::reconfigure));
+    m_signal_tracker.join(m_theme.reconfigSig(), FbTk::MemFun(*this, &Toolbar::themeReconfigured));
 
     // listen to screen size changes
     m_signal_tracker.join(screen().resizeSig(),
@@ -371,6 +371,40 @@ void Toolbar::relayout() {
     forAll(m_item_list, std::bind2nd(std::mem_fun(&ToolbarItem::renderTheme), alpha()));
 }
 
+void Toolbar::themeReconfigured() {
+    if (!theme()->onlyColorsChanged()) {
+        reconfigure();
+        return;
+    }
+
+    renderBackground();
+    frame.window.clear();
+    // tools with parent relative textures show the new background
+    forAll(m_item_list, std::bind2nd(std::mem_fun(&ToolbarItem::renderTheme), alpha()));
+}
+
+void Toolbar::renderBackground() {
+    Pixmap tmp = m_window_pm;
+    if (!theme()->toolbar().usePixmap()) {
+        m_window_pm = 0;
+        frame.window.setBackgroundColor(theme()->toolbar().color());
+    } else {
+        FbTk::Orientation orient = FbTk::ROT0;
+        Toolbar::Placement where = *m_rc_placement;
+        if (where == LEFTCENTER || where == LEFTTOP || where == LEFTBOTTOM)
+            orient = FbTk::ROT270;
+        if (where == RIGHTCENTER || where == RIGHTTOP || where == RIGHTBOTTOM)
+            orient = FbTk::ROT90;
+
+        m_window_pm = screen().imageControl().renderImage(
+                          frame.window.width(), frame.window.height(),
+                          theme()->toolbar(), orient);
+        frame.window.setBackgroundPixmap(m_window_pm);
+    }
+    if (tmp)
+        screen().imageControl().removeImage(tmp);
+}
+
 void Toolbar::reconfigure() {
 
     updateVisibleState();
@@ -459,26 +493,7 @@ void Toolbar::reconfigure() {
                                 frame.width, frame.height);
     }
 
-    // render frame window
-    Pixmap tmp = m_window_pm;
-    if (!theme()->toolbar().usePixmap()) {
-        m_window_pm = 0;
-        frame.window.setBackgroundColor(theme()->toolbar().color());
-    } else {
-        FbTk::Orientation orient = FbTk::ROT0;
-        Toolbar::Placement where = *m_rc_placement;
-        if (where == LEFTCENTER || where == LEFTTOP || where == LEFTBOTTOM)
-            orient = FbTk::ROT270;
-        if (where == RIGHTCENTER || where == RIGHTTOP || where == RIGHTBOTTOM)
-            orient = FbTk::ROT90;
-
-        m_window_pm = screen().imageControl().renderImage(
-                          frame.window.width(), frame.window.height(),
-                          theme()->toolbar(), orient);
-        frame.window.setBackgroundPixmap(m_window_pm);
-    }
-    if (tmp)
-        screen().imageControl().removeImage(tmp);
+    renderBackground();
 
     frame.window.setBorderColor(theme()->border().color());
     frame.window.setBorderWidth(theme()->border().width());
@@ -144,6 +144,9 @@ private:
     void clearStrut();
     void updateStrut();
     void updateAlpha();
+    /// a new style only renders the background if nothing else changed
+    void themeReconfigured();
+    void renderBackground();
 
     void updateCrossingState();
 
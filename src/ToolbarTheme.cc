@@ -47,6 +47,11 @@ ToolbarTheme::~ToolbarTheme() {
 
 }
 
+bool ToolbarTheme::onlyColorsChanged() const {
+    const FbTk::ThemeItem_base *colors[] = { &m_toolbar };
+    return onlyChanged(colors, 1);
+}
+
 bool ToolbarTheme::fallback(FbTk::ThemeItem_base &item) {
     if (item.name().find(".borderWidth") != string::npos) {
         return FbTk::ThemeManager::instance().loadItem(item, "borderWidth", "BorderWidth");
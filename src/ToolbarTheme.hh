@@ -44,6 +44,9 @@ public:
     int height() const { return *m_height; }
     int buttonSize() const { return *m_button_size; }
 
+    /// @return true if the last load that changed the theme only changed the texture
+    bool onlyColorsChanged() const;
+
     virtual FbTk::Signal<> &reconfigSig() { return FbTk::Theme::reconfigSig(); }
 
     virtual ToolbarTheme &operator *() { return *this; }
@@ -99,6 +99,9 @@ WinClient::WinClient(Window win, BScreen &screen, FluxboxWindow *fbwin):
                      m_strut(0) {
 
     old_bw = borderWidth();
+    // properties are cached from now on, so we need to hear of their
+    // changes before the window gets its frame
+    setEventMask(PropertyChangeMask);
     updateWMProtocols();
     updateMWMHints();
     updateWMHints();
@@ -226,9 +229,31 @@ bool WinClient::getWMIconName(XTextProperty &textprop) const {
 }
 
 string WinClient::getWMRole() const {
-    Atom wm_role = XInternAtom(FbTk::App::instance()->display(),
-                               "WM_WINDOW_ROLE", False);
-    return textProperty(wm_role);
+    static Atom wm_role = XInternAtom(FbTk::App::instance()->display(),
+                                      "WM_WINDOW_ROLE", False);
+    return getTextProperty(wm_role);
+}
+
+long WinClient::getCardinalProperty(Atom prop, bool *exists) const {
+    CachedProperty &cached = m_property_cache[prop];
+    if (!cached.has_cardinal) {
+        cached.cardinal = cardinalProperty(prop, &cached.cardinal_exists);
+        cached.has_cardinal = true;
+    }
+    if (exists)
+        *exists = cached.cardinal_exists;
+    return cached.cardinal;
+}
+
+FbTk::FbString WinClient::getTextProperty(Atom prop, bool *exists) const {
+    CachedProperty &cached = m_property_cache[prop];
+    if (!cached.has_text) {
+        cached.text = textProperty(prop, &cached.text_exists);
+        cached.has_text = true;
+    }
+    if (exists)
+        *exists = cached.text_exists;
+    return cached.text;
 }
 
 void WinClient::updateWMClassHint() {
@@ -96,8 +96,12 @@ public:
     std::string getWMRole() const;
     WindowState::WindowType getWindowType() const { return m_window_type; }
     void setWindowType(WindowState::WindowType type) { m_window_type = type; }
-    long getCardinalProperty(Atom prop,bool*exists=NULL) const { return FbTk::FbWindow::cardinalProperty(prop,exists); }
-    FbTk::FbString getTextProperty(Atom prop,bool*exists=NULL) const { return FbTk::FbWindow::textProperty(prop,exists); }
+    /// @return the property, read from the server only if it changed since the last time
+    long getCardinalProperty(Atom prop,bool*exists=NULL) const;
+    /// @return the property, read from the server only if it changed since the last time
+    FbTk::FbString getTextProperty(Atom prop,bool*exists=NULL) const;
+    /// drops the cached values of a property, called on PropertyNotify
+    void propertyChanged(Atom prop) { m_property_cache.erase(prop); }
 
     WinClient *transientFor() { return transient_for; }
     const WinClient *transientFor() const { return transient_for; }
@@ -165,6 +169,18 @@ private:
     SizeHints m_size_hints;
 
     Strut *m_strut;
+
+    struct CachedProperty {
+        CachedProperty(): has_text(false), has_cardinal(false),
+                          text_exists(false), cardinal_exists(false), cardinal(0) { }
+        bool has_text, has_cardinal; ///< which of the values were read
+        bool text_exists, cardinal_exists;
+        FbTk::FbString text;
+        long cardinal;
+    };
+    typedef std::map<Atom, CachedProperty> PropertyCache;
+    mutable PropertyCache m_property_cache;
+
     // map transient_for X window to winclient transient 
     // (used if transient_for FbWindow was created after transient)    
     // Since a lot of transients can be created before transient_for 
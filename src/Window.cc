@@ -285,6 +285,9 @@ FluxboxWindow::FluxboxWindow(WinClient &client):
     display(FbTk::App::instance()->display()),
     m_button_grab_x(0), m_button_grab_y(0),
     m_last_move_x(0), m_last_move_y(0),
+    m_move_pending_x(0), m_move_pending_y(0),
+    m_move_pending(false),
+    m_last_move_time(0),
     m_last_resize_h(1), m_last_resize_w(1),
     m_last_pressed_button(0),
     m_workspace_number(0),
@@ -306,8 +309,19 @@ FluxboxWindow::FluxboxWindow(WinClient &client):
     m_parent(client.screen().rootWindow()),
     m_resize_corner(RIGHTBOTTOM) {
 
-    join(m_theme.reconfigSig(), FbTk::MemFun(*this, &FluxboxWindow::themeReconfigured));
+    // the other state's theme can be of another size
+    join(focusSig(), FbTk::MemFunIgnoreArgs(*this, &FluxboxWindow::themeReconfigured));
+    join(attentionSig(), FbTk::MemFunIgnoreArgs(*this, &FluxboxWindow::themeReconfigured));
+    join(m_theme.focusedTheme().reconfigSig(),
+         FbTk::MemFun(*this, &FluxboxWindow::styleReconfigured));
+    join(m_theme.unfocusedTheme().reconfigSig(),
+         FbTk::MemFun(*this, &FluxboxWindow::styleReconfigured));
+    join(m_theme.focusedTheme()->iconbarTheme().reconfigSig(),
+         FbTk::MemFun(*this, &FluxboxWindow::styleReconfigured));
+    join(m_theme.unfocusedTheme()->iconbarTheme().reconfigSig(),
+         FbTk::MemFun(*this, &FluxboxWindow::styleReconfigured));
     join(m_frame.frameExtentSig(), FbTk::MemFun(*this, &FluxboxWindow::frameExtentChanged));
+    join(m_frame.geometrySig(), FbTk::MemFun(*this, &FluxboxWindow::frameGeometryChanged));
 
     init();
 
@@ -363,6 +377,7 @@ FluxboxWindow::~FluxboxWindow() {
 
     m_timer.stop();
     m_tabActivationTimer.stop();
+    m_move_timer.stop();
 
     // notify die
     dieSig().emit(*this);
@@ -449,6 +464,11 @@ void FluxboxWindow::init() {
     m_tabActivationTimer.setCommand(activate_tab_cmd);
     m_tabActivationTimer.fireOnce(true);
 
+    m_move_timer.fireOnce(true);
+    FbTk::RefCount<FbTk::Command<void> > apply_move(new FbTk::SimpleCommand<FluxboxWindow>(*this,
+                                                                                   &FluxboxWindow::applyPendingMove));
+    m_move_timer.setCommand(apply_move);
+
     m_reposLabels_timer.setTimeout(IconButton::updateLaziness());
     m_reposLabels_timer.fireOnce(true);
     FbTk::RefCount<FbTk::Command<void> > elrs(new FbTk::SimpleCommand<FluxboxWindow>(*this, &FluxboxWindow::emitLabelReposSig));
@@ -574,11 +594,13 @@ void FluxboxWindow::init() {
            twin->title().logical()<<endl;
     }
 
+    // place before joining the workspace, so the workspace's cached free
+    // space doesn't have to be rebuilt without us
+    if (!m_placed)
+        placeWindow(getOnHead());
     screen().getWorkspace(m_workspace_number)->addWindow(*this);
     if (m_placed)
         moveResize(frame().x(), frame().y(), real_width, real_height);
-    else
-        placeWindow(getOnHead());
 
     setFocusFlag(false); // update graphics before mapping
 
@@ -1428,6 +1450,7 @@ void FluxboxWindow::iconify() {
 
     m_state.iconic = true;
     m_statesig.emit(*this);
+    frameGeometryChanged(); // leaves the workspace's index
 
     hide(true);
 
@@ -1457,6 +1480,7 @@ void FluxboxWindow::deiconify(bool do_raise) {
     screen().reassociateWindow(this, m_workspace_number, false);
     m_state.iconic = false;
     m_statesig.emit(*this);
+    frameGeometryChanged();
 
     // deiconify all transients
     ClientList::iterator client_it = clientList().begin();
@@ -1638,6 +1662,7 @@ void FluxboxWindow::setWorkspace(int n) {
 
 void FluxboxWindow::setLayerNum(int layernum) {
     m_state.layernum = layernum;
+    frameGeometryChanged();
 
     if (m_initialized) {
         fbdbg<<this<<" notify layer signal"<<endl;
@@ -2528,134 +2553,23 @@ void FluxboxWindow::motionNotifyEvent(XMotionEvent &me) {
 
     if (moving || m_attaching_tab) {
 
-        XEvent e;
-
-        if (XCheckTypedEvent(display, MotionNotify, &e)) {
-            XPutBackEvent(display, &e);
-            return;
-        }
-
-        const bool xor_outline = m_attaching_tab || !screen().doOpaqueMove();
-
-        // Warp to next or previous workspace?, must have moved sideways some
-        int moved_x = me.x_root - m_last_resize_x;
-
-        // Warp to a workspace offset (if treating workspaces like a grid)
-        int moved_y = me.y_root - m_last_resize_y;
-
-        // save last event point
-        m_last_resize_x = me.x_root;
-        m_last_resize_y = me.y_root;
-
-        // undraw rectangle before warping workspaces
-        if (xor_outline) {
-            int bw = static_cast<int>(frame().window().borderWidth());
-            int w = static_cast<int>(frame().width()) + 2*bw -1;
-            int h = static_cast<int>(frame().height()) + 2*bw - 1;
-            if (w > 0 && h > 0) {
-                parent().drawRectangle(screen().rootTheme()->opGC(),
-                    m_last_move_x, m_last_move_y, w, h);
-            }
-        }
-
-
-        // check for warping
-        //
-        // +--monitor-1--+--monitor-2---+
-        // |w            |             w|
-        // |w            |             w|
-        // +-------------+--------------+
-        //
-        // mouse-warping is enabled, the mouse needs to be in the "warp_pad"
-        // zone.
-        //
-        const int  warp_pad            = screen().getEdgeSnapThreshold();
-        const int  workspaces          = screen().numberOfWorkspaces();
-        const bool is_warping          = screen().isWorkspaceWarping();
-        const bool is_warping_vertical = screen().isWorkspaceWarpingVertical();
-
-        if ((moved_x || moved_y) && is_warping) {
-            unsigned int cur_id = screen().currentWorkspaceID();
-            unsigned int new_id = cur_id;
-
-            // border threshold
-            int bt_right  = int(screen().width()) - warp_pad - 1;
-            int bt_left   = warp_pad;
-            int bt_top    = int(screen().height()) - warp_pad - 1;
-            int bt_bottom = warp_pad;
-
-            if (moved_x) {
-                if (me.x_root >= bt_right && moved_x > 0) { //warp right
-                    new_id          = (cur_id + 1) % workspaces;
-                    m_last_resize_x = 0;
-                } else if (me.x_root <= bt_left && moved_x < 0) { //warp left
-                    new_id          = (cur_id +  -1) % workspaces;
-                    m_last_resize_x = screen().width() - 1;
-                }
-            }
-
-            if (moved_y && is_warping_vertical) {
-
-                const int warp_offset = screen().getWorkspaceWarpingVerticalOffset();
-
-                if (me.y_root >= bt_top && moved_y > 0) { // warp down
-                    new_id          = (cur_id + warp_offset) % workspaces;
-                    m_last_resize_y = 0;
-                } else if (me.y_root <= bt_bottom && moved_y < 0) { // warp up
-                    new_id          = (cur_id + workspaces - warp_offset) % workspaces;
-                    m_last_resize_y = screen().height() - 1;
-                }
-            }
-
-            // if we are warping
-            if (new_id != cur_id) {
-                // remove motion events from queue to avoid repeated warps
-                while (XCheckTypedEvent(display, MotionNotify, &e)) {
-                    // might as well update the y-coordinate
-                    m_last_resize_y = e.xmotion.y_root;
-                }
-
-                // move the pointer to (m_last_resize_x,m_last_resize_y)
-                XWarpPointer(display, None, me.root, 0, 0, 0, 0,
-                        m_last_resize_x, m_last_resize_y);
-
-                if (m_attaching_tab || // tabbing grabs the pointer, we must not hide the window!
-                            screen().doOpaqueMove())
-                    screen().sendToWorkspace(new_id, this, true);
-                else
-                    screen().changeWorkspaceID(new_id, false);
-            }
-        }
-
-        int dx = m_last_resize_x - m_button_grab_x,
-            dy = m_last_resize_y - m_button_grab_y;
-
-        dx -= frame().window().borderWidth();
-        dy -= frame().window().borderWidth();
+        // only remember where the pointer is; the frame follows at most
+        // once per refresh interval, no matter how fast the mouse reports
+        m_move_pending_x = me.x_root;
+        m_move_pending_y = me.y_root;
+        m_move_pending = true;
 
-        // dx = current left side, dy = current top
-        if (moving)
-            doSnapping(dx, dy);
-
-        // do not update display if another motion event is already pending
-
-        if (xor_outline) {
-            int bw = frame().window().borderWidth();
-            int w = static_cast<int>(frame().width()) + 2*bw - 1;
-            int h = static_cast<int>(frame().height()) + 2*bw - 1;
-            if (w > 0 && h > 0) {
-                parent().drawRectangle(screen().rootTheme()->opGC(), dx, dy, w, h);
-            }
-            m_last_move_x = dx;
-            m_last_move_y = dy;
-        } else {
-            //moveResize(dx, dy, frame().width(), frame().height());
-            // need to move the base window without interfering with transparency
-            frame().quietMoveResize(dx, dy, frame().width(), frame().height());
+        uint64_t now = FbTk::FbTime::mono();
+        uint64_t interval = screen().opaqueMoveInterval();
+        uint64_t elapsed = now - m_last_move_time;
+
+        if (elapsed >= interval) {
+            m_move_timer.stop();
+            applyPendingMove();
+        } else if (!m_move_timer.isTiming()) {
+            m_move_timer.setTimeout(interval - elapsed);
+            m_move_timer.start();
         }
-        if (moving)
-            screen().showPosition(dx, dy);
-        // end if moving
     } else if (resizing) {
 
         int old_resize_x = m_last_resize_x;
@@ -2796,6 +2710,138 @@ void FluxboxWindow::motionNotifyEvent(XMotionEvent &me) {
     }
 }
 
+void FluxboxWindow::applyPendingMove() {
+
+    if (!m_move_pending || !(moving || m_attaching_tab))
+        return;
+
+    m_move_pending = false;
+    m_last_move_time = FbTk::FbTime::mono();
+
+    const int x_root = m_move_pending_x;
+    const int y_root = m_move_pending_y;
+
+    const bool xor_outline = m_attaching_tab || !screen().doOpaqueMove();
+
+    // Warp to next or previous workspace?, must have moved sideways some
+    int moved_x = x_root - m_last_resize_x;
+
+    // Warp to a workspace offset (if treating workspaces like a grid)
+    int moved_y = y_root - m_last_resize_y;
+
+    // save last event point
+    m_last_resize_x = x_root;
+    m_last_resize_y = y_root;
+
+    // undraw rectangle before warping workspaces
+    if (xor_outline) {
+        int bw = static_cast<int>(frame().window().borderWidth());
+        int w = static_cast<int>(frame().width()) + 2*bw -1;
+        int h = static_cast<int>(frame().height()) + 2*bw - 1;
+        if (w > 0 && h > 0) {
+            parent().drawRectangle(screen().rootTheme()->opGC(),
+                m_last_move_x, m_last_move_y, w, h);
+        }
+    }
+
+
+    // check for warping
+    //
+    // +--monitor-1--+--monitor-2---+
+    // |w            |             w|
+    // |w            |             w|
+    // +-------------+--------------+
+    //
+    // mouse-warping is enabled, the mouse needs to be in the "warp_pad"
+    // zone.
+    //
+    const int  warp_pad            = screen().getEdgeSnapThreshold();
+    const int  workspaces          = screen().numberOfWorkspaces();
+    const bool is_warping          = screen().isWorkspaceWarping();
+    const bool is_warping_vertical = screen().isWorkspaceWarpingVertical();
+
+    if ((moved_x || moved_y) && is_warping) {
+        unsigned int cur_id = screen().currentWorkspaceID();
+        unsigned int new_id = cur_id;
+
+        // border threshold
+        int bt_right  = int(screen().width()) - warp_pad - 1;
+        int bt_left   = warp_pad;
+        int bt_top    = int(screen().height()) - warp_pad - 1;
+        int bt_bottom = warp_pad;
+
+        if (moved_x) {
+            if (x_root >= bt_right && moved_x > 0) { //warp right
+                new_id          = (cur_id + 1) % workspaces;
+                m_last_resize_x = 0;
+            } else if (x_root <= bt_left && moved_x < 0) { //warp left
+                new_id          = (cur_id +  -1) % workspaces;
+                m_last_resize_x = screen().width() - 1;
+            }
+        }
+
+        if (moved_y && is_warping_vertical) {
+
+            const int warp_offset = screen().getWorkspaceWarpingVerticalOffset();
+
+            if (y_root >= bt_top && moved_y > 0) { // warp down
+                new_id          = (cur_id + warp_offset) % workspaces;
+                m_last_resize_y = 0;
+            } else if (y_root <= bt_bottom && moved_y < 0) { // warp up
+                new_id          = (cur_id + workspaces - warp_offset) % workspaces;
+                m_last_resize_y = screen().height() - 1;
+            }
+        }
+
+        // if we are warping
+        if (new_id != cur_id) {
+            XEvent e;
+            // remove motion events from queue to avoid repeated warps
+            while (XCheckTypedEvent(display, MotionNotify, &e)) {
+                // might as well update the y-coordinate
+                m_last_resize_y = e.xmotion.y_root;
+            }
+
+            // move the pointer to (m_last_resize_x,m_last_resize_y)
+            XWarpPointer(display, None, screen().rootWindow().window(), 0, 0, 0, 0,
+                    m_last_resize_x, m_last_resize_y);
+
+            if (m_attaching_tab || // tabbing grabs the pointer, we must not hide the window!
+                        screen().doOpaqueMove())
+                screen().sendToWorkspace(new_id, this, true);
+            else
+                screen().changeWorkspaceID(new_id, false);
+        }
+    }
+
+    int dx = m_last_resize_x - m_button_grab_x,
+        dy = m_last_resize_y - m_button_grab_y;
+
+    dx -= frame().window().borderWidth();
+    dy -= frame().window().borderWidth();
+
+    // dx = current left side, dy = current top
+    if (moving)
+        doSnapping(dx, dy);
+
+    if (xor_outline) {
+        int bw = frame().window().borderWidth();
+        int w = static_cast<int>(frame().width()) + 2*bw - 1;
+        int h = static_cast<int>(frame().height()) + 2*bw - 1;
+        if (w > 0 && h > 0) {
+            parent().drawRectangle(screen().rootTheme()->opGC(), dx, dy, w, h);
+        }
+        m_last_move_x = dx;
+        m_last_move_y = dy;
+    } else {
+        //moveResize(dx, dy, frame().width(), frame().height());
+        // need to move the base window without interfering with transparency
+        frame().quietMoveResize(dx, dy, frame().width(), frame().height());
+    }
+    if (moving)
+        screen().showPosition(dx, dy);
+}
+
 void FluxboxWindow::enterNotifyEvent(XCrossingEvent &ev) {
 
     static FluxboxWindow *s_last_really_entered = 0;
@@ -2906,11 +2952,22 @@ void FluxboxWindow::frameExtentChanged() {
     }
 }
 
+void FluxboxWindow::frameGeometryChanged() {
+    Workspace *space = screen().getWorkspace(m_workspace_number);
+    if (space)
+        space->updateWindowIndex(*this);
+}
+
 void FluxboxWindow::themeReconfigured() {
     frame().applyDecorations();
     sendConfigureNotify();
 }
 
+void FluxboxWindow::styleReconfigured() {
+    if (!frame().renderChangedFaces())
+        themeReconfigured();
+}
+
 void FluxboxWindow::workspaceAreaChanged(BScreen &screen) {
     frame().applyState();
 }
@@ -3030,6 +3087,13 @@ void FluxboxWindow::startMoving(int x, int y) {
 }
 
 void FluxboxWindow::stopMoving(bool interrupted) {
+
+    // the frame has to end up where the pointer was released
+    if (!interrupted)
+        applyPendingMove();
+    m_move_timer.stop();
+    m_move_pending = false;
+
     moving = false;
     Fluxbox *fluxbox = Fluxbox::instance();
 
@@ -3192,11 +3256,17 @@ void FluxboxWindow::doSnapping(int &orig_left, int &orig_top, bool resize) {
     /////////////////////////////////////
     // now check window edges
 
-    Workspace::Windows &wins =
-        screen().currentWorkspace()->windowList();
+    // only windows within reach of the threshold can snap
+    vector<FluxboxWindow *> wins;
+    screen().currentWorkspace()->findWindows(-1,
+            std::min(left, left - xoff) - threshold,
+            std::min(top, top - yoff) - threshold,
+            std::max(right, right - xoff + woff) - std::min(left, left - xoff) + 2 * threshold,
+            std::max(bottom, bottom - yoff + hoff) - std::min(top, top - yoff) + 2 * threshold,
+            wins);
 
-    Workspace::Windows::iterator it = wins.begin();
-    Workspace::Windows::iterator it_end = wins.end();
+    vector<FluxboxWindow *>::iterator it = wins.begin();
+    vector<FluxboxWindow *>::iterator it_end = wins.end();
 
     unsigned int bw;
     for (; it != it_end; ++it) {
@@ -3417,6 +3487,9 @@ void FluxboxWindow::attachTo(int x, int y, bool interrupted) {
     if (m_attaching_tab == 0)
         return;
 
+    m_move_timer.stop();
+    m_move_pending = false;
+
     parent().drawRectangle(screen().rootTheme()->opGC(),
                            m_last_move_x, m_last_move_y,
                            m_last_resize_w, m_last_resize_h);
@@ -498,6 +498,8 @@ private:
     void grabButtons();
 
     void themeReconfigured();
+    /// after a style load, that might only have changed textures
+    void styleReconfigured();
 
     /**
      * Calculates insertition position in the list by
@@ -521,6 +523,9 @@ private:
     void setFullscreenLayer();
     void attachWorkAreaSig();
 
+    /// moves the frame (or outline) to the last pointer position seen
+    /// while moving; called at most once per refresh interval
+    void applyPendingMove();
     // modifies left and top if snap is necessary
     void doSnapping(int &left, int &top, bool resize = false);
     // user_w/h return the values that should be shown to the user
@@ -544,6 +549,8 @@ private:
     /// Called when workspace area on screen changed.
     void workspaceAreaChanged(BScreen &screen);
     void frameExtentChanged();
+    /// keeps the workspace's spatial index up to date
+    void frameGeometryChanged();
 
 
     // state and hint signals
@@ -553,6 +560,7 @@ private:
     uint64_t m_last_keypress_time;
     FbTk::Timer m_timer;
     FbTk::Timer m_tabActivationTimer;
+    FbTk::Timer m_move_timer; ///< paces applyPendingMove()
 
     // Window states
     bool moving, resizing, m_initialized;
@@ -564,6 +572,9 @@ private:
     int m_button_grab_x, m_button_grab_y; // handles last button press event for move
     int m_last_resize_x, m_last_resize_y; // handles last button press event for resize
     int m_last_move_x, m_last_move_y; // handles last pos for non opaque moving
+    int m_move_pending_x, m_move_pending_y; // last pointer pos not yet applied to the frame
+    bool m_move_pending;
+    uint64_t m_last_move_time; // when the frame was moved last, in microseconds
     int m_last_resize_h, m_last_resize_w; // handles height/width for resize "window"
     int m_last_pressed_button;
 
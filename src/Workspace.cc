@@ -35,6 +35,8 @@
 #include "FbTk/StringUtil.hh"
 #include "FbTk/FbString.hh"
 #include "FbTk/MemFun.hh"
+#include "FbTk/Layer.hh"
+#include "FbTk/LayerItem.hh"
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
@@ -54,8 +56,27 @@
 
 using std::string;
 
+namespace {
+
+// the area a window occupies on the screen, tabs included
+void frameRectangle(const FluxboxWindow &win, int &x, int &y, int &w, int &h) {
+    const int bw = 2 * win.frame().window().borderWidth();
+    x = win.x() - win.xOffset();
+    y = win.y() - win.yOffset();
+    w = win.width() + bw + win.widthOffset();
+    h = win.height() + bw + win.heightOffset();
+}
+
+bool compareIndexOrder(const std::pair<unsigned long, FluxboxWindow *> &a,
+                       const std::pair<unsigned long, FluxboxWindow *> &b) {
+    return a.first < b.first;
+}
+
+} // end of anonymous namespace
+
 Workspace::Workspace(BScreen &scrn, const string &name, unsigned int id):
     m_screen(scrn),
+    m_index_order(0),
     m_clientmenu(scrn, m_windowlist, false),
     m_name(name),
     m_id(id) {
@@ -78,9 +99,8 @@ void Workspace::addWindow(FluxboxWindow &w) {
     if (find(m_windowlist.begin(), m_windowlist.end(), &w) != m_windowlist.end())
         return;
 
-    w.setWorkspace(m_id);
+    insertWindow(w);
 
-    m_windowlist.push_back(&w);
     m_clientlist_sig.emit();
 
 }
@@ -102,23 +122,108 @@ int Workspace::removeWindow(FluxboxWindow *w, bool still_alive) {
     if (w->isFocused() && !w->isTransient() && still_alive)
         FocusControl::unfocusWindow(w->winClient(), true, true);
 
-    m_windowlist.remove(w);
+    eraseWindow(*w);
+
     m_clientlist_sig.emit();
 
     return m_windowlist.size();
 }
 
-void Workspace::showAll() {
+void Workspace::moveStuckWindows(Workspace &dest) {
+    if (&dest == this)
+        return;
+
+    // the windows stay where they are on the screen, so unlike
+    // removeWindow() this leaves their focus alone; the caller reverts
+    // focus once for the whole switch
+    Windows stuck;
     Windows::iterator it = m_windowlist.begin();
-    Windows::iterator it_end = m_windowlist.end();
+    for (; it != m_windowlist.end(); ++it) {
+        if ((*it)->isStuck())
+            stuck.push_back(*it);
+    }
+
+    if (stuck.empty())
+        return;
+
+    for (it = stuck.begin(); it != stuck.end(); ++it) {
+        eraseWindow(**it);
+        dest.insertWindow(**it);
+    }
+
+    m_clientlist_sig.emit();
+    dest.m_clientlist_sig.emit();
+}
+
+void Workspace::insertWindow(FluxboxWindow &w) {
+    w.setWorkspace(m_id);
+
+    m_windowlist.push_back(&w);
+
+    IndexPosition pos = { w.layerNum(), ++m_index_order, false, 0, 0, 0, 0 };
+    m_index_pos[&w] = pos;
+    updateWindowIndex(w);
+}
+
+void Workspace::eraseWindow(FluxboxWindow &w) {
+    m_windowlist.remove(&w);
+
+    IndexPositions::iterator pos = m_index_pos.find(&w);
+    if (pos != m_index_pos.end()) {
+        m_index[pos->second.layer].remove(&w);
+        m_free_space.erase(pos->second.layer);
+        m_index_pos.erase(pos);
+    }
+}
+
+void Workspace::stackingOrder(Windows &result) const {
+    result.clear();
+
+    std::map<const FbTk::LayerItem *, FluxboxWindow *> items;
+    Windows::const_iterator win_it = m_windowlist.begin();
+    for (; win_it != m_windowlist.end(); ++win_it)
+        items[&(*win_it)->layerItem()] = *win_it;
+
+    // layer 0 is the top one, and every layer lists its items top first
+    FbTk::MultLayers &layers = m_screen.layerManager();
+    for (int layer = 0; layer < layers.size() && !items.empty(); ++layer) {
+        const FbTk::Layer::ItemList &list = layers.getLayer(layer)->itemList();
+        FbTk::Layer::ItemList::const_iterator it = list.begin();
+        for (; it != list.end(); ++it) {
+            std::map<const FbTk::LayerItem *, FluxboxWindow *>::iterator
+                item = items.find(*it);
+            if (item == items.end())
+                continue;
+            result.push_back(item->second);
+            items.erase(item);
+        }
+    }
+
+    // anything not stacked (yet) goes to the bottom
+    for (win_it = m_windowlist.begin(); win_it != m_windowlist.end(); ++win_it) {
+        if (items.count(&(*win_it)->layerItem()))
+            result.push_back(*win_it);
+    }
+}
+
+void Workspace::showAll() {
+    // map from the top down: a window mapped below the ones already shown
+    // only gets exposed where it actually is visible
+    Windows stacked;
+    stackingOrder(stacked);
+    Windows::iterator it = stacked.begin();
+    Windows::iterator it_end = stacked.end();
     for (; it != it_end; ++it)
         (*it)->show();
 }
 
 
 void Workspace::hideAll(bool interrupt_moving) {
-    Windows::reverse_iterator it = m_windowlist.rbegin();
-    Windows::reverse_iterator it_end = m_windowlist.rend();
+    // unmap from the bottom up, for the same reason
+    Windows stacked;
+    stackingOrder(stacked);
+    Windows::reverse_iterator it = stacked.rbegin();
+    Windows::reverse_iterator it_end = stacked.rend();
     for (; it != it_end; ++it) {
         if (! (*it)->isStuck())
             (*it)->hide(interrupt_moving);
@@ -150,6 +255,127 @@ size_t Workspace::numberOfWindows() const {
     return m_windowlist.size();
 }
 
+void Workspace::updateWindowIndex(FluxboxWindow &win) {
+
+    IndexPositions::iterator it = m_index_pos.find(&win);
+    if (it == m_index_pos.end())
+        return;
+
+    IndexPosition &pos = it->second;
+
+    // iconified windows cover nothing
+    if (win.isIconic()) {
+        if (pos.indexed) {
+            m_index[pos.layer].remove(&win);
+            m_free_space.erase(pos.layer);
+            pos.indexed = false;
+        }
+        return;
+    }
+
+    int x, y, w, h;
+    frameRectangle(win, x, y, w, h);
+
+    if (pos.indexed) {
+        // whatever the window no longer covers may have become free,
+        // which the cached free space can't express
+        if (pos.layer != win.layerNum() ||
+            x > pos.x || y > pos.y ||
+            x + w < pos.x + pos.width || y + h < pos.y + pos.height)
+            m_free_space.erase(pos.layer);
+
+        if (pos.layer != win.layerNum())
+            m_index[pos.layer].remove(&win);
+    }
+
+    pos.layer = win.layerNum();
+    pos.indexed = true;
+    pos.x = x;
+    pos.y = y;
+    pos.width = w;
+    pos.height = h;
+    m_index[pos.layer].insert(&win, x, y, w, h, pos.order);
+
+    LayerFreeSpace::iterator spaces = m_free_space.find(pos.layer);
+    if (spaces != m_free_space.end()) {
+        for (size_t i = 0; i < spaces->second.size(); ++i)
+            spaces->second[i].occupy(x, y, w, h);
+    }
+}
+
+void Workspace::findWindows(int layernum, int x, int y, int width, int height,
+                            std::vector<FluxboxWindow *> &result) const {
+
+    if (layernum >= 0) {
+        LayerIndex::const_iterator it = m_index.find(layernum);
+        if (it != m_index.end())
+            it->second.query(x, y, width, height, result);
+        return;
+    }
+
+    // every layer: merge the layers back into window list order
+    std::vector<FluxboxWindow *> found;
+    LayerIndex::const_iterator it = m_index.begin();
+    for (; it != m_index.end(); ++it)
+        it->second.query(x, y, width, height, found);
+
+    std::vector<std::pair<unsigned long, FluxboxWindow *> > ordered;
+    ordered.reserve(found.size());
+    for (size_t i = 0; i < found.size(); ++i)
+        ordered.push_back(std::make_pair(m_index_pos.find(found[i])->second.order, found[i]));
+    std::sort(ordered.begin(), ordered.end(), compareIndexOrder);
+
+    for (size_t i = 0; i < ordered.size(); ++i)
+        result.push_back(ordered[i].second);
+}
+
+const FreeSpace &Workspace::freeSpace(int layernum, int x, int y, int width, int height,
+                                      const FluxboxWindow *ignore) {
+
+    // the cache covers every window, leaving one out means starting over
+    if (ignore) {
+        IndexPositions::const_iterator pos =
+            m_index_pos.find(const_cast<FluxboxWindow *>(ignore));
+        if (pos != m_index_pos.end() && pos->second.indexed &&
+            pos->second.layer == layernum &&
+            pos->second.x < x + width && pos->second.x + pos->second.width > x &&
+            pos->second.y < y + height && pos->second.y + pos->second.height > y) {
+            buildFreeSpace(layernum, x, y, width, height, ignore, m_scratch_space);
+            return m_scratch_space;
+        }
+    }
+
+    std::vector<FreeSpace> &spaces = m_free_space[layernum];
+    for (size_t i = 0; i < spaces.size(); ++i) {
+        if (spaces[i].hasBounds(x, y, width, height))
+            return spaces[i];
+    }
+
+    // one area per head, older ones are from before the struts changed
+    if (spaces.size() > static_cast<size_t>(std::max(m_screen.numHeads(), 1)))
+        spaces.erase(spaces.begin());
+
+    spaces.push_back(FreeSpace());
+    buildFreeSpace(layernum, x, y, width, height, 0, spaces.back());
+    return spaces.back();
+}
+
+void Workspace::buildFreeSpace(int layernum, int x, int y, int width, int height,
+                               const FluxboxWindow *ignore, FreeSpace &space) const {
+
+    space.reset(x, y, width, height);
+
+    std::vector<FluxboxWindow *> wins;
+    findWindows(layernum, x, y, width, height, wins);
+    for (size_t i = 0; i < wins.size(); ++i) {
+        if (wins[i] == ignore)
+            continue;
+        int wx, wy, ww, wh;
+        frameRectangle(*wins[i], wx, wy, ww, wh);
+        space.occupy(wx, wy, ww, wh);
+    }
+}
+
 void Workspace::setName(const string &name) {
     if (!name.empty() && name != "") {
         if (name == m_name)
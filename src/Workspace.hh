@@ -26,12 +26,16 @@
 #define     WORKSPACE_HH
 
 #include "ClientMenu.hh"
+#include "FreeSpace.hh"
+#include "SpatialIndex.hh"
 
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/Signal.hh"
 
 #include <string>
 #include <list>
+#include <map>
+#include <vector>
 
 class BScreen;
 class FluxboxWindow;
@@ -60,7 +64,11 @@ public:
     /// Add @a win to this workspace, placing it if @a place is true
     void addWindow(FluxboxWindow &win);
     int removeWindow(FluxboxWindow *win, bool still_alive);
+    /// Move all stuck windows over to @a dest at once, without touching focus
+    void moveStuckWindows(Workspace &dest);
     void updateClientmenu();
+    /// keep the spatial index in sync after @a win moved, resized or changed layer
+    void updateWindowIndex(FluxboxWindow &win);
 
     BScreen &screen() { return m_screen; }
     const BScreen &screen() const { return m_screen; }
@@ -79,12 +87,53 @@ public:
 
     size_t numberOfWindows() const;
 
+    /**
+     * Collects the windows whose frames (including external tabs) touch
+     * the given area. Iconified windows are left out.
+     * @param layernum only look at this layer, negative means all layers
+     * @param result receives the windows, in the order of windowList()
+     */
+    void findWindows(int layernum, int x, int y, int width, int height,
+                     std::vector<FluxboxWindow *> &result) const;
+
+    /**
+     * The free space of a layer within the given area. It is cached and
+     * kept up to date while windows arrive and grow; a window that leaves,
+     * moves or shrinks makes the next call start over.
+     * @param ignore a window to leave out, eg. the one being placed
+     */
+    const FreeSpace &freeSpace(int layernum, int x, int y, int width, int height,
+                               const FluxboxWindow *ignore = 0);
+
 private:
     void placeWindow(FluxboxWindow &win);
+    /// adds/removes @a win to/from the lists without notifying anyone
+    void insertWindow(FluxboxWindow &win);
+    void eraseWindow(FluxboxWindow &win);
+    /// the windows of this workspace, top first
+    void stackingOrder(Windows &result) const;
+    void buildFreeSpace(int layernum, int x, int y, int width, int height,
+                        const FluxboxWindow *ignore, FreeSpace &space) const;
+
+    typedef SpatialIndex<FluxboxWindow *> WindowIndex;
+    typedef std::map<int, WindowIndex> LayerIndex;
+    struct IndexPosition {
+        int layer;
+        unsigned long order; ///< position in m_windowlist
+        bool indexed;        ///< false while the window is iconified
+        int x, y, width, height; ///< last indexed frame rectangle
+    };
+    typedef std::map<FluxboxWindow *, IndexPosition> IndexPositions;
+    typedef std::map<int, std::vector<FreeSpace> > LayerFreeSpace;
 
     BScreen &m_screen;
 
     Windows m_windowlist;
+    LayerIndex m_index; ///< frame rectangles of m_windowlist, per layer
+    IndexPositions m_index_pos;
+    unsigned long m_index_order;
+    LayerFreeSpace m_free_space; ///< cached free space per layer and area
+    FreeSpace m_scratch_space;
     FbTk::Signal<> m_clientlist_sig;
     ClientMenu m_clientmenu;
 
@@ -34,6 +34,8 @@
 #include "FocusControl.hh"
 #include "WindowCmd.hh"
 
+#include "FbTk/App.hh"
+#include "FbTk/FbTime.hh"
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/CommandParser.hh"
 #include "FbTk/stringstream.hh"
@@ -46,9 +48,12 @@
 #endif
 #include <algorithm>
 #include <functional>
+#include <iostream>
 #include <vector>
 
 using std::string;
+using std::cerr;
+using std::endl;
 
 REGISTER_COMMAND_PARSER(map, WindowListCmd::parse, void);
 REGISTER_COMMAND_PARSER(foreach, WindowListCmd::parse, void);
@@ -345,6 +350,8 @@ FbTk::Command<void> *parseIntCmd(const string &command, const string &args,
     else if (command == "workspace")
         // workspaces appear 1-indexed to the user, hence the minus 1
         return new JumpToWorkspaceCmd(num - 1);
+    else if (command == "benchmarkworkspaceswitch")
+        return new BenchmarkWorkspaceSwitchCmd(args.empty() ? 10 : num);
     return 0;
 }
 
@@ -353,6 +360,7 @@ REGISTER_COMMAND_PARSER(prevworkspace, parseIntCmd, void);
 REGISTER_COMMAND_PARSER(rightworkspace, parseIntCmd, void);
 REGISTER_COMMAND_PARSER(leftworkspace, parseIntCmd, void);
 REGISTER_COMMAND_PARSER(workspace, parseIntCmd, void);
+REGISTER_COMMAND_PARSER(benchmarkworkspaceswitch, parseIntCmd, void);
 
 } // end anonymous namespace
 
@@ -394,6 +402,44 @@ void JumpToWorkspaceCmd::execute() {
     }
 }
 
+void BenchmarkWorkspaceSwitchCmd::execute() {
+    BScreen *screen = Fluxbox::instance()->mouseScreen();
+    if (screen == 0 || screen->numberOfWorkspaces() < 2)
+        return;
+
+    const unsigned int start = screen->currentWorkspaceID();
+    const unsigned int count = screen->numberOfWorkspaces();
+    uint64_t total = 0, fastest = 0, slowest = 0;
+    size_t windows = 0;
+
+    // every switch includes the round trip, so the server has
+    // handled everything we sent by the time it is taken
+    FbTk::App::instance()->sync(false);
+    for (int round = 0; round < m_rounds; ++round) {
+        for (unsigned int i = 1; i <= count; ++i) {
+            unsigned int id = (start + i) % count;
+            windows += screen->getWorkspace(id)->numberOfWindows();
+
+            uint64_t begin = FbTk::FbTime::mono();
+            screen->changeWorkspaceID(id);
+            FbTk::App::instance()->sync(false);
+            uint64_t took = FbTk::FbTime::mono() - begin;
+
+            total += took;
+            if (took > slowest)
+                slowest = took;
+            if (fastest == 0 || took < fastest)
+                fastest = took;
+        }
+    }
+
+    const unsigned long switches = static_cast<unsigned long>(m_rounds) * count;
+    cerr<<"BenchmarkWorkspaceSwitch: "<<switches<<" switches, "
+        <<windows / switches<<" windows per workspace, "
+        <<"min/avg/max "<<fastest<<"/"<<total / switches<<"/"<<slowest
+        <<" microseconds"<<endl;
+}
+
 /**
   try to arrange the windows on the current workspace in a 'clever' way.
   we take the shaded-windows and put them ontop of the workspace and put the
@@ -669,7 +715,7 @@ void ToggleSlitAboveCmd::execute() {
 #if USE_SLIT
     if (BScreen *screen = Fluxbox::instance()->mouseScreen()) {
         screen->slit()->toggleAboveDock();
-        const_cast<FbTk::FbWindow&>(screen->slit()->window()).raise();
+        screen->slit()->raise();
     }
 #endif
 }
@@ -679,7 +725,7 @@ void ToggleSlitHiddenCmd::execute() {
 #if USE_SLIT
     if (BScreen *screen = Fluxbox::instance()->mouseScreen()) {
         screen->slit()->toggleHidden();
-        const_cast<FbTk::FbWindow&>(screen->slit()->window()).raise();
+        screen->slit()->raise();
     }
 #endif
 }
@@ -689,7 +735,7 @@ void ToggleToolbarAboveCmd::execute() {
 #if USE_TOOLBAR
     if (BScreen *screen = Fluxbox::instance()->mouseScreen()) {
         screen->toolbar()->toggleAboveDock();
-        const_cast<FbTk::FbWindow&>(screen->toolbar()->window()).raise();
+        screen->toolbar()->raise();
     }
 #endif
 }
@@ -699,7 +745,7 @@ void ToggleToolbarHiddenCmd::execute() {
 #if USE_TOOLBAR
     if (BScreen *screen = Fluxbox::instance()->mouseScreen()) {
         screen->toolbar()->toggleHidden();
-        const_cast<FbTk::FbWindow&>(screen->toolbar()->window()).raise();
+        screen->toolbar()->raise();
     }
 #endif
 }
@@ -167,6 +167,16 @@ private:
     const int m_workspace_num;
 };
 
+/// switches through all workspaces and reports how long the switches took
+class BenchmarkWorkspaceSwitchCmd: public FbTk::Command<void> {
+public:
+    explicit BenchmarkWorkspaceSwitchCmd(int rounds):
+        m_rounds(rounds < 1 ? 1 : rounds) { }
+    void execute();
+private:
+    const int m_rounds;
+};
+
 /// arranges windows in current workspace to rows and columns
 class ArrangeWindowsCmd: public FbTk::Command<void> {
 public:
@@ -35,7 +35,9 @@ struct Options {
     std::string rc_path;
     std::string rc_file;
     std::string log_filename;
+    std::string startup_trace;
     bool xsync;
+    bool startup_profile;
 };
 
 
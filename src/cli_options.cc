@@ -41,7 +41,7 @@ using std::cout;
 using std::endl;
 using std::string;
 
-FluxboxCli::Options::Options() : xsync(false) {
+FluxboxCli::Options::Options() : xsync(false), startup_profile(false) {
 
     const char* env = getenv("DISPLAY");
     if (env && strlen(env) > 0) {
@@ -107,6 +107,16 @@ int FluxboxCli::Options::parse(int argc, char** argv) {
             this->log_filename = argv[i];
         } else if (arg == "-sync" || arg == "--sync") {
             this->xsync = true;
+        } else if (arg == "-startup-profile" || arg == "--startup-profile") {
+            this->startup_profile = true;
+        } else if (arg == "-startup-trace" || arg == "--startup-trace") {
+            if (++i >= argc) {
+                cerr<<_FB_CONSOLETEXT(main, StartupTraceRequiresArg,
+                                      "error: '-startup-trace' needs an argument", "")<<endl;
+                return EXIT_FAILURE;
+            }
+            this->startup_profile = true;
+            this->startup_trace = argv[i];
         } else if (arg == "-help" || arg == "-h" || arg == "--help") {
             // print program usage and command line options
             printf(_FB_CONSOLETEXT(main, Usage,
@@ -122,6 +132,8 @@ int FluxboxCli::Options::parse(int argc, char** argv) {
                            "-list-commands\t\t\tlist all valid key commands.\n"
                            "-sync\t\t\t\tsynchronize with X server for debugging.\n"
                            "-log <filename>\t\t\tlog output to file.\n"
+                           "-startup-profile\t\ttime the startup phases.\n"
+                           "-startup-trace <filename>\talso write them as a Chrome trace.\n"
                            "-help\t\t\t\tdisplay this help text and exit.\n\n",
 
                            "Main usage string. Please lay it out nicely. One %%s gives the version, ther other gives the year").c_str(),
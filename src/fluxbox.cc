@@ -34,6 +34,7 @@
 #include "FbAtoms.hh"
 #include "FocusControl.hh"
 #include "Layer.hh"
+#include "StartupProfile.hh"
 
 #include "defaults.hh"
 #include "Debug.hh"
@@ -46,8 +47,9 @@
 #include "FbTk/StringUtil.hh"
 #include "FbTk/Util.hh"
 #include "FbTk/Resource.hh"
+#include "FbTk/AutoReloadHelper.hh"
 #include "FbTk/SimpleCommand.hh"
-#include "FbTk/XrmDatabaseHelper.hh"
+#include "FbTk/ResourceDatabase.hh"
 #include "FbTk/Command.hh"
 #include "FbTk/RefCount.hh"
 #include "FbTk/CompareEqual.hh"
@@ -274,6 +276,9 @@ Fluxbox::Fluxbox(int argc, char **argv,
       m_showing_dialog(false),
       m_server_grabs(0) {
 
+    // FbTk::App connected, and FbAtoms made the first atoms
+    StartupProfile::mark("open display");
+
     _FB_USES_NLS;
 
     m_state.restarting = false;
@@ -337,6 +342,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 #endif // HAVE_RANDR
 
     load_rc();
+    StartupProfile::mark("init file");
     grab();
 
     if (! XSupportsLocale())
@@ -357,12 +363,16 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
     // setup theme manager to have our style file ready to be scanned
     FbTk::ThemeManager::instance().load(getStyleFilename(), getStyleOverlayFilename());
+    m_style_reloader.reset(new FbTk::AutoReloadHelper());
+    watchStyle();
+    StartupProfile::mark("style");
 
     // Create keybindings handler and load keys file
     // Note: this needs to be done before creating screens
     m_key.reset(new Keys);
     m_key->reconfigure();
     FbTk::MenuSearch::setMode(*m_config.menusearch);
+    StartupProfile::mark("keys");
 
     unsigned int opts = OPT_SLIT|OPT_TOOLBAR;
     vector<int> screens;
@@ -436,6 +446,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 #ifdef USE_EWMH
     addAtomHandler(new Ewmh());
 #endif // USE_EWMH
+    StartupProfile::mark("atoms");
     // parse apps file after creating screens (so we can tell if it's a restart
     // for [startup] items) but before creating windows
     // this needs to be after ewmh and gnome, so state atoms don't get
@@ -443,6 +454,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 #ifdef REMEMBER
     addAtomHandler(new Remember()); // for remembering window attribs
 #endif // REMEMBER
+    StartupProfile::mark("apps");
 
     // init all "screens"
     STLUtil::forAll(m_screens, bind1st(mem_fun(&Fluxbox::initScreen), this));
@@ -462,6 +474,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
     }
 
     m_state.starting = false;
+    StartupProfile::mark("setup");
     //
     // For dumping theme items
     // FbTk::ThemeManager::instance().listItems();
@@ -490,6 +503,7 @@ void Fluxbox::initScreen(BScreen *screen) {
 
     // now we can create menus (which needs this screen to be in screen_list)
     screen->initMenus();
+    StartupProfile::mark("menus", screen->screenNumber());
     screen->initWindows();
 
     // attach screen signals to this
@@ -501,6 +515,8 @@ void Fluxbox::initScreen(BScreen *screen) {
 
     join(screen->clientListSig(),
          FbTk::MemFun(*this, &Fluxbox::clientListChanged));
+    join(screen->clientStackingSig(),
+         FbTk::MemFun(*this, &Fluxbox::clientStackingChanged));
 
     join(screen->workspaceNamesSig(), 
          FbTk::MemFun(*this, &Fluxbox::workspaceNamesChanged));
@@ -516,6 +532,7 @@ void Fluxbox::initScreen(BScreen *screen) {
     //STLUtil::forAll(m_atomhandler, bind2nd(mem_fun(&AtomHandler::initForScreen), *screen));
 
     FocusControl::revertFocus(*screen); // make sure focus style is correct
+    StartupProfile::mark("hints and focus", screen->screenNumber());
 
 }
 
@@ -541,6 +558,7 @@ void Fluxbox::eventLoop() {
                 handleEvent(&e);
             }
         } else {
+            StartupProfile::finish();
             FbTk::Timer::updateTimers(ConnectionNumber(disp));
         }
     }
@@ -611,6 +629,11 @@ void Fluxbox::handleEvent(XEvent * const e) {
         BScreen *screen = searchScreen(e->xproperty.window);
         if (screen) {
             screen->propertyNotify(e->xproperty.atom);
+        } else {
+            // before anyone reads the new value
+            WinClient *winclient = searchWindow(e->xproperty.window);
+            if (winclient)
+                winclient->propertyChanged(e->xproperty.atom);
         }
     }
 
@@ -1150,6 +1173,7 @@ void Fluxbox::save_rc() {
     XrmMergeDatabases(new_rc, &old_rc);
     XrmPutFileDatabase(old_rc, dbfile.c_str());
     XrmDestroyDatabase(old_rc);
+    FbTk::ResourceDatabase::forget(dbfile);
 
     fbdbg<<__FILE__<<"("<<__LINE__<<"): ------------ SAVING DONE"<<endl;
 
@@ -1206,11 +1230,11 @@ void Fluxbox::load_rc(BScreen &screen) {
     _FB_USES_NLS;
     string dbfile(getRcFilename());
 
-    XrmDatabaseHelper database;
-
-    database = XrmGetFileDatabase(dbfile.c_str());
-    if (database==0)
-        database = XrmGetFileDatabase(DEFAULT_INITFILE);
+    // the same database the resource managers load from
+    std::shared_ptr<const FbTk::ResourceDatabase> database =
+        FbTk::ResourceDatabase::open(dbfile);
+    if (database == 0)
+        database = FbTk::ResourceDatabase::open(DEFAULT_INITFILE);
 
     screen.removeWorkspaceNames();
 
@@ -1223,12 +1247,9 @@ void Fluxbox::load_rc(BScreen &screen) {
     class_lookup += screen_number;
     class_lookup += ".WorkspaceNames";
 
-    XrmValue value;
-    char *value_type;
-    if (XrmGetResource(*database, name_lookup.c_str(), class_lookup.c_str(), &value_type,
-                       &value)) {
+    string values;
+    if (database != 0 && database->lookup(name_lookup, class_lookup, values)) {
 
-        string values(value.addr);
         BScreen::WorkspaceNames names;
 
         StringUtil::removeTrailingWhitespace(values);
@@ -1308,6 +1329,27 @@ void Fluxbox::real_reconfigure() {
     m_key->reconfigure();
     STLUtil::forAll(m_atomhandler, mem_fun(&AtomHandler::reconfigure));
     FbTk::MenuSearch::setMode(*m_config.menusearch);
+    watchStyle();
+}
+
+void Fluxbox::saveStyleFilename(const char *val) {
+    m_config.style_file = (val == 0 ? "" : val);
+    watchStyle();
+}
+
+void Fluxbox::watchStyle() {
+    // the style is loaded already, the reload command is just for changes
+    m_style_reloader->setReloadCmd(FbTk::RefCount<FbTk::Command<void> >());
+    m_style_reloader->setMainFile(getStyleFilename());
+    m_style_reloader->addFile(getStyleOverlayFilename());
+    m_style_reloader->setReloadCmd(FbTk::RefCount<FbTk::Command<void> >(new FbTk::SimpleCommand<Fluxbox>(*this, &Fluxbox::reloadStyle)));
+}
+
+void Fluxbox::reloadStyle() {
+    m_style_reloader->addFile(getStyleOverlayFilename());
+    if (FbTk::ThemeManager::instance().load(getStyleFilename(),
+                                            getStyleOverlayFilename()))
+        reconfigThemes();
 }
 
 BScreen *Fluxbox::findScreen(int id) {
@@ -1391,6 +1433,11 @@ void Fluxbox::clientListChanged(BScreen &screen) {
             CallMemFunWithRefArg<AtomHandler, BScreen&, void>(&AtomHandler::updateClientList, screen));
 }
 
+void Fluxbox::clientStackingChanged(BScreen &screen) {
+    STLUtil::forAllIf(m_atomhandler, mem_fun(&AtomHandler::update),
+            CallMemFunWithRefArg<AtomHandler, BScreen&, void>(&AtomHandler::updateClientStacking, screen));
+}
+
 void Fluxbox::focusedWindowChanged(BScreen &screen, 
                                    FluxboxWindow* win, 
                                    WinClient* client) {
@@ -53,6 +53,10 @@
 #include <vector>
 #include <cstdio>
 
+namespace FbTk {
+class AutoReloadHelper;
+}
+
 class AtomHandler;
 class FluxboxWindow;
 class WinClient;
@@ -139,7 +143,7 @@ public:
 
     void shutdown(int x_wants_down = 0);
     void load_rc(BScreen &scr);
-    void saveStyleFilename(const char *val) { m_config.style_file = (val == 0 ? "" : val); }
+    void saveStyleFilename(const char *val);
     void saveWindowSearch(Window win, WinClient *winclient);
     // some windows relate to the group, not the client, so we record separately
     // searchWindow on these windows will give the active client in the group
@@ -190,6 +194,9 @@ private:
     std::string getRcFilename();
     void load_rc();
     void real_reconfigure();
+    /// keeps m_style_reloader on the current style and overlay
+    void watchStyle();
+    void reloadStyle();
     void handleEvent(XEvent *xe);
     void handleUnmapNotify(XUnmapEvent &ue);
     void handleClientMessage(XClientMessageEvent &ce);
@@ -202,6 +209,7 @@ private:
     void workspaceNamesChanged(BScreen &screen);
     /// Called when the client list changed.
     void clientListChanged(BScreen &screen);
+    void clientStackingChanged(BScreen &screen);
     /// Called when the focused window changed on a screen
     void focusedWindowChanged(BScreen &screen,
                               FluxboxWindow* win,
@@ -261,6 +269,7 @@ private:
 
 
     std::unique_ptr<Keys>    m_key;
+    std::unique_ptr<FbTk::AutoReloadHelper> m_style_reloader;
     AtomHandlerContainer   m_atomhandler;
     AttentionNoticeHandler m_attention_handler;
 
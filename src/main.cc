@@ -24,6 +24,7 @@
 #include "version.h"
 #include "defaults.hh"
 #include "cli.hh"
+#include "StartupProfile.hh"
 
 #include "FbTk/I18n.hh"
 #include "FbTk/StringUtil.hh"
@@ -165,6 +166,9 @@ int main(int argc, char **argv) {
     if (exitcode != -1) {
         exit(exitcode);
     }
+
+    if (opts.startup_profile)
+        StartupProfile::enable(opts.startup_trace);
     exitcode = EXIT_FAILURE;
 
 #ifdef __EMX__
@@ -198,6 +202,7 @@ int main(int argc, char **argv) {
 
     FluxboxCli::setupConfigFiles(opts.rc_path, opts.rc_file);
     FluxboxCli::updateConfigFilesIfNeeded(opts.rc_file);
+    StartupProfile::mark("config files");
 
     try {
 
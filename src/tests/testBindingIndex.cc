@@ -0,0 +1,153 @@
+#include "BindingIndex.hh"
+
+#include <X11/X.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Binding {
+    int type;
+    unsigned int mod;
+    unsigned int key;
+    int context;
+    bool isdouble;
+    std::list<std::shared_ptr<Binding> > keylist; ///< keychain continuations
+};
+
+typedef std::shared_ptr<Binding> Ref;
+
+// the scan Keys::t_key::find() used before
+Ref scan(const std::list<Ref> &keylist, int type, unsigned int mod, unsigned int key,
+         int context, bool isdouble) {
+    std::list<Ref>::const_iterator it = keylist.begin();
+    for (; it != keylist.end(); ++it) {
+        if ((*it)->type == type && (*it)->key == key &&
+            ((*it)->context & context) > 0 &&
+            isdouble == (*it)->isdouble && (*it)->mod == mod)
+            return *it;
+    }
+    return Ref();
+}
+
+const int TYPES[] = { KeyPress, ButtonPress, ButtonRelease, MotionNotify };
+const unsigned int MODS[] = { 0, ShiftMask, ControlMask, Mod1Mask, Mod4Mask,
+                              Mod1Mask|ShiftMask, ControlMask|Mod1Mask };
+
+Ref randomBinding() {
+    Ref b(new Binding);
+    b->type = TYPES[rand() % 4];
+    b->mod = MODS[rand() % 7];
+    b->key = b->type == KeyPress ? 8 + rand() % 100 : 1 + rand() % 9;
+    b->context = 1 << (rand() % 12);
+    b->isdouble = b->type == ButtonPress && rand() % 4 == 0;
+    return b;
+}
+
+double seconds(clock_t start) {
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+} // end of anonymous namespace
+
+int test_find() {
+
+    printf("testing BindingIndex::find() against the list scan, 500 bindings\n");
+
+    srand(11);
+
+    // 500 bindings in the top level key mode, a fifth of them starting
+    // keychains of up to 10 further bindings
+    std::list<Ref> top;
+    std::vector<Ref> chains;
+    for (int i = 0; i < 500; ++i) {
+        Ref b = randomBinding();
+        if (i % 5 == 0) {
+            b->type = KeyPress;
+            b->isdouble = false;
+            for (int j = rand() % 10; j >= 0; --j)
+                b->keylist.push_back(randomBinding());
+            chains.push_back(b);
+        }
+        top.push_back(b);
+    }
+
+    BindingIndex<Ref> top_index;
+    top_index.build(top.begin(), top.end());
+    std::vector<BindingIndex<Ref> > chain_index(chains.size());
+    for (size_t i = 0; i < chains.size(); ++i)
+        chain_index[i].build(chains[i]->keylist.begin(), chains[i]->keylist.end());
+
+    // events, mostly motion and presses nothing is bound to
+    struct Event { int type; unsigned int mod, key; int context; bool isdouble; int chain; };
+    std::vector<Event> events;
+    for (int i = 0; i < 200000; ++i) {
+        Ref b = randomBinding();
+        Event e = { b->type, b->mod, b->key, b->context | (rand() % 2 ? 1 << (rand() % 12) : 0),
+                    b->isdouble, rand() % 3 == 0 ? rand() % int(chains.size()) : -1 };
+        events.push_back(e);
+    }
+
+    int failed = 0;
+    size_t hits = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event &e = events[i];
+        const std::list<Ref> &list = e.chain < 0 ? top : chains[e.chain]->keylist;
+        const BindingIndex<Ref> &index = e.chain < 0 ? top_index : chain_index[e.chain];
+        Ref expected = scan(list, e.type, e.mod, e.key, e.context, e.isdouble);
+        Ref got = index.find(e.type, e.mod, e.key, e.context, e.isdouble);
+        if (got != expected) {
+            if (failed < 10)
+                printf("  event %lu: wrong binding\n", (unsigned long)i);
+            ++failed;
+        }
+        hits += got ? 1 : 0;
+    }
+
+    // and the benchmark
+    const int ROUNDS = 5;
+    size_t found = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < events.size(); ++i) {
+            const Event &e = events[i];
+            found += scan(e.chain < 0 ? top : chains[e.chain]->keylist,
+                          e.type, e.mod, e.key, e.context, e.isdouble) ? 1 : 0;
+        }
+    }
+    double scan_time = seconds(start);
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < events.size(); ++i) {
+            const Event &e = events[i];
+            found += (e.chain < 0 ? top_index : chain_index[e.chain]).
+                find(e.type, e.mod, e.key, e.context, e.isdouble) ? 1 : 0;
+        }
+    }
+    double index_time = seconds(start);
+
+    printf("  %lu lookups (%lu hits): scan %.3fs, index %.3fs\n",
+           (unsigned long)(events.size() * ROUNDS), (unsigned long)hits,
+           scan_time, index_time);
+    if (found != 2 * hits * ROUNDS)
+        ++failed;
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = 0;
+    failed += test_find();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+#include "FreeSpace.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+typedef FreeSpace::Rect Rect;
+
+namespace {
+
+const int HEAD_WIDTH = 1600, HEAD_HEIGHT = 1000;
+
+bool overlaps(const Rect &r, int x, int y, int width, int height) {
+    return r.x < x + width && r.x + r.width > x &&
+           r.y < y + height && r.y + r.height > y;
+}
+
+// the stepping scan RowSmartPlacement used before
+bool rowScan(const std::vector<Rect> &windows, int win_w, int win_h,
+             bool left_right, bool top_bot, int &place_x, int &place_y) {
+
+    int test_y = top_bot ? 0 : HEAD_HEIGHT - win_h;
+    while (top_bot ? test_y + win_h <= HEAD_HEIGHT : test_y >= 0) {
+        int test_x = left_right ? 0 : HEAD_WIDTH - win_w;
+        int next_y = top_bot ? HEAD_HEIGHT : -1;
+
+        while (left_right ? test_x + win_w <= HEAD_WIDTH : test_x >= 0) {
+            bool placed = true;
+            int next_x = test_x + (left_right ? 1 : -1);
+            for (size_t i = 0; i < windows.size(); ++i) {
+                const Rect &r = windows[i];
+                if (!overlaps(r, test_x, test_y, win_w, win_h))
+                    continue;
+                placed = false;
+                if (left_right) {
+                    if (r.x + r.width > next_x)
+                        next_x = r.x + r.width;
+                } else if (r.x - win_w < next_x)
+                    next_x = r.x - win_w;
+                if (top_bot) {
+                    if (r.y + r.height < next_y)
+                        next_y = r.y + r.height;
+                } else if (r.y - win_h > next_y)
+                    next_y = r.y - win_h;
+            }
+            if (placed) {
+                place_x = test_x;
+                place_y = test_y;
+                return true;
+            }
+            test_x = next_x;
+        }
+        test_y = next_y;
+    }
+    return false;
+}
+
+// the stepping scan ColSmartPlacement used before
+bool colScan(const std::vector<Rect> &windows, int win_w, int win_h,
+             bool left_right, bool top_bot, int &place_x, int &place_y) {
+
+    int test_x = left_right ? 0 : HEAD_WIDTH - win_w;
+    while (left_right ? test_x + win_w <= HEAD_WIDTH : test_x >= 0) {
+        int test_y = top_bot ? 0 : HEAD_HEIGHT - win_h;
+        int next_x = left_right ? HEAD_WIDTH : -1;
+
+        while (top_bot ? test_y + win_h <= HEAD_HEIGHT : test_y >= 0) {
+            bool placed = true;
+            int next_y = test_y + (top_bot ? 1 : -1);
+            for (size_t i = 0; i < windows.size(); ++i) {
+                const Rect &r = windows[i];
+                if (!overlaps(r, test_x, test_y, win_w, win_h))
+                    continue;
+                placed = false;
+                if (top_bot) {
+                    if (r.y + r.height > next_y)
+                        next_y = r.y + r.height;
+                } else if (r.y - win_h < next_y)
+                    next_y = r.y - win_h;
+                if (left_right) {
+                    if (r.x + r.width < next_x)
+                        next_x = r.x + r.width;
+                } else if (r.x - win_w > next_x)
+                    next_x = r.x - win_w;
+            }
+            if (placed) {
+                place_x = test_x;
+                place_y = test_y;
+                return true;
+            }
+            test_y = next_y;
+        }
+        test_x = next_x;
+    }
+    return false;
+}
+
+} // end of anonymous namespace
+
+int test_find() {
+
+    printf("testing FreeSpace::find() against the placement scans\n");
+
+    srand(3);
+    int failed = 0;
+
+    for (int round = 0; round < 300; ++round) {
+        std::vector<Rect> windows;
+        FreeSpace space;
+        space.reset(0, 0, HEAD_WIDTH, HEAD_HEIGHT);
+
+        const int count = rand() % 25;
+        for (int i = 0; i < count; ++i) {
+            Rect r = { rand() % HEAD_WIDTH - 100, rand() % HEAD_HEIGHT - 100,
+                       1 + rand() % 500, 1 + rand() % 400 };
+            windows.push_back(r);
+            space.occupy(r.x, r.y, r.width, r.height);
+        }
+
+        const int w = 20 + rand() % 600, h = 20 + rand() % 500;
+        for (int mode = 0; mode < 8; ++mode) {
+            const bool rows = (mode & 1) == 0;
+            const bool left_right = (mode & 2) == 0;
+            const bool top_bot = (mode & 4) == 0;
+
+            int x = 0, y = 0, ref_x = 0, ref_y = 0;
+            bool found = space.find(w, h, rows, left_right, top_bot, x, y);
+            bool ref_found = rows ?
+                rowScan(windows, w, h, left_right, top_bot, ref_x, ref_y) :
+                colScan(windows, w, h, left_right, top_bot, ref_x, ref_y);
+
+            if (found != ref_found || (found && (x != ref_x || y != ref_y))) {
+                printf("  round %d, mode %d: got %d (%d,%d), expected %d (%d,%d): failed\n",
+                       round, mode, found, x, y, ref_found, ref_x, ref_y);
+                ++failed;
+            }
+        }
+    }
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = 0;
+    failed += test_find();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+#include "MinOverlap.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <set>
+#include <vector>
+
+using MinOverlap::Frame;
+
+namespace {
+
+// the straightforward O(n^3) search MinOverlap::findPosition() replaced;
+// both have to agree on every layout
+
+MinOverlap::Order s_order;
+bool s_right_to_left, s_bottom_to_top;
+
+struct Area {
+    enum Corner { TOPLEFT, TOPRIGHT, BOTTOMLEFT, BOTTOMRIGHT } corner;
+    int x, y;
+
+    Area(Corner c, int _x, int _y): corner(c), x(_x), y(_y) { }
+
+    bool operator <(const Area &o) const {
+        if (s_order == MinOverlap::ROWS) {
+            if (y != o.y)
+                return ((y < o.y) ^ s_bottom_to_top);
+            if (x != o.x)
+                return ((x < o.x) ^ s_right_to_left);
+        } else {
+            if (x != o.x)
+                return ((x < o.x) ^ s_right_to_left);
+            if (y != o.y)
+                return ((y < o.y) ^ s_bottom_to_top);
+        }
+        return (corner < o.corner);
+    }
+};
+
+void referencePosition(const std::vector<Frame> &frames,
+                       int head_left, int head_top, int head_right, int head_bot,
+                       int win_w, int win_h, int &x, int &y) {
+
+    std::set<Area> areas;
+    areas.insert(Area(Area::TOPLEFT, head_left, head_top));
+    areas.insert(Area(Area::TOPRIGHT, head_right - win_w, head_top));
+    areas.insert(Area(Area::BOTTOMLEFT, head_left, head_bot - win_h));
+    areas.insert(Area(Area::BOTTOMRIGHT, head_right - win_w, head_bot - win_h));
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const Frame &f = frames[i];
+        if (!f.edges)
+            continue;
+        std::set<Area>::iterator ar = areas.begin();
+        for (; ar != areas.end(); ++ar) {
+            switch (ar->corner) {
+            case Area::TOPLEFT:
+                if (f.right > ar->x && f.bottom > ar->y) {
+                    if (f.bottom + win_h <= head_bot)
+                        areas.insert(Area(Area::TOPLEFT, ar->x, f.bottom));
+                    if (f.right + win_w <= head_right)
+                        areas.insert(Area(Area::TOPLEFT, f.right, ar->y));
+                }
+                break;
+            case Area::TOPRIGHT:
+                if (f.left < ar->x + win_w && f.bottom > ar->y) {
+                    if (f.bottom + win_h <= head_bot)
+                        areas.insert(Area(Area::TOPRIGHT, ar->x, f.bottom));
+                    if (f.left - win_w >= head_left)
+                        areas.insert(Area(Area::TOPRIGHT, f.left - win_w, ar->y));
+                }
+                break;
+            case Area::BOTTOMRIGHT:
+                if (f.left < ar->x + win_w && f.top < ar->y + win_h) {
+                    if (f.top - win_h >= head_top)
+                        areas.insert(Area(Area::BOTTOMRIGHT, ar->x, f.top - win_h));
+                    if (f.left - win_w >= head_left)
+                        areas.insert(Area(Area::BOTTOMRIGHT, f.left - win_w, ar->y));
+                }
+                break;
+            case Area::BOTTOMLEFT:
+                if (f.right > ar->x && f.top < ar->y + win_h) {
+                    if (f.top - win_h >= head_top)
+                        areas.insert(Area(Area::BOTTOMLEFT, ar->x, f.top - win_h));
+                    if (f.right + win_w <= head_right)
+                        areas.insert(Area(Area::BOTTOMLEFT, f.right, ar->y));
+                }
+                break;
+            }
+        }
+    }
+
+    int min_so_far = win_w * win_h * frames.size() + 1;
+    std::set<Area>::iterator min_reg = areas.end();
+    for (std::set<Area>::iterator ar = areas.begin(); ar != areas.end(); ++ar) {
+        int overlap = 0;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            const Frame &f = frames[i];
+            int min_right = std::min(f.right, ar->x + win_w);
+            int min_bottom = std::min(f.bottom, ar->y + win_h);
+            int max_left = std::max(f.left, ar->x);
+            int max_top = std::max(f.top, ar->y);
+            if (min_right > max_left && min_bottom > max_top)
+                overlap += (min_right - max_left) * (min_bottom - max_top);
+        }
+        if (overlap < min_so_far) {
+            min_reg = ar;
+            min_so_far = overlap;
+            if (overlap == 0)
+                break;
+        }
+    }
+
+    x = min_reg->x;
+    y = min_reg->y;
+}
+
+const int HEAD_WIDTH = 1920, HEAD_HEIGHT = 1080;
+
+void randomLayout(size_t count, std::vector<Frame> &frames) {
+    frames.clear();
+    for (size_t i = 0; i < count; ++i) {
+        Frame f;
+        f.left = rand() % HEAD_WIDTH - 100;
+        f.top = rand() % HEAD_HEIGHT - 100;
+        f.right = f.left + 50 + rand() % 600;
+        f.bottom = f.top + 50 + rand() % 400;
+        f.edges = (rand() % 8 != 0); // some in other layers
+        frames.push_back(f);
+    }
+}
+
+double seconds(clock_t start) {
+    return static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+}
+
+} // end of anonymous namespace
+
+int test_reference() {
+
+    printf("testing MinOverlap::findPosition() against the reference search\n");
+
+    srand(7);
+    int failed = 0;
+    std::vector<Frame> frames;
+
+    const size_t counts[] = { 0, 1, 2, 5, 10, 30, 60, 120 };
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        for (int round = 0; round < 10; ++round) {
+            randomLayout(counts[c], frames);
+            int w = 100 + rand() % 700, h = 100 + rand() % 500;
+
+            for (int mode = 0; mode < 8; ++mode) {
+                s_order = (mode & 1) ? MinOverlap::COLUMNS : MinOverlap::ROWS;
+                s_right_to_left = (mode & 2) != 0;
+                s_bottom_to_top = (mode & 4) != 0;
+
+                int x, y, ref_x, ref_y;
+                MinOverlap::findPosition(frames, s_order, s_right_to_left, s_bottom_to_top,
+                                         0, 0, HEAD_WIDTH, HEAD_HEIGHT, w, h, x, y);
+                referencePosition(frames, 0, 0, HEAD_WIDTH, HEAD_HEIGHT, w, h, ref_x, ref_y);
+
+                if (x != ref_x || y != ref_y) {
+                    printf("  %u windows, mode %d: got %d,%d, expected %d,%d: failed\n",
+                           (unsigned int)counts[c], mode, x, y, ref_x, ref_y);
+                    ++failed;
+                }
+            }
+        }
+    }
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int bench_placement() {
+
+    printf("benchmarking placement on random layouts\n");
+
+    srand(11);
+    s_order = MinOverlap::ROWS;
+    s_right_to_left = false;
+    s_bottom_to_top = false;
+
+    std::vector<Frame> frames;
+    const size_t counts[] = { 10, 50, 100, 250, 500, 1000 };
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        randomLayout(counts[c], frames);
+
+        int x, y;
+        int runs = 0;
+        clock_t start = clock();
+        do {
+            MinOverlap::findPosition(frames, s_order, s_right_to_left, s_bottom_to_top,
+                                     0, 0, HEAD_WIDTH, HEAD_HEIGHT, 640, 480, x, y);
+            ++runs;
+        } while (seconds(start) < 0.2);
+        double fast = seconds(start) / runs;
+
+        // the reference gets slow quickly, only time it where it's bearable
+        double slow = 0;
+        if (counts[c] <= 250) {
+            runs = 0;
+            start = clock();
+            do {
+                referencePosition(frames, 0, 0, HEAD_WIDTH, HEAD_HEIGHT, 640, 480, x, y);
+                ++runs;
+            } while (seconds(start) < 0.2);
+            slow = seconds(start) / runs;
+        }
+
+        if (slow > 0)
+            printf("  %4u windows: %9.3f ms (reference %9.3f ms)\n",
+                   (unsigned int)counts[c], fast * 1000, slow * 1000);
+        else
+            printf("  %4u windows: %9.3f ms\n", (unsigned int)counts[c], fast * 1000);
+    }
+
+    printf("done.\n");
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = 0;
+    failed += test_reference();
+    failed += bench_placement();
+
+    return failed ? 1 : 0;
+}
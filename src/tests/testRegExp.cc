@@ -0,0 +1,182 @@
+#include "FbTk/RegExp.hh"
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#ifdef USE_REGEXP
+#include <regex.h>
+#endif // USE_REGEXP
+
+namespace {
+
+// the kind of terms apps files and window patterns are made of
+const char *PATTERNS[] = {
+    // literals
+    "xterm", "XTerm", "Firefox", "Navigator", "gimp-2.10", "Gimp\\.bin",
+    "org\\.gnome\\.Nautilus", "yes", "no", "0", "3", "", "fbrun",
+    "Dialog\\(1\\)", "C\\+\\+ \\*scratch\\*",
+    // prefix, suffix and contains
+    ".*Mozilla Firefox", "Navigator.*", ".*- Vim", ".*Chromium.*", ".*",
+    "gimp\\..*", ".*\\.pdf",
+    // automaton
+    "[Xx]term", "(xterm|urxvt|st)", "urxvt[0-9]*", "Gimp-?2\\.[0-9]+",
+    "[^ ]+ - Chromium", "a.c", "(foo|bar)baz?", "(ab)+c", "x(y|z)*",
+    ".*[Tt]hunderbird.*", "[a-z]+", "[A-Z][a-z]*", "(Mail|Calendar) - .*",
+    "[-a]+", "[a-]+", "[^a-z]+", "mpv|",
+    // left to POSIX
+    "xterm|urxvt", "x{2}", "[[:digit:]]+", "\\w+", "^foo$", "a**",
+    "\xc3\xa9.*", "Caf\xc3\xa9", "(", "[z-a]", "[]a]", "\\(", "a{1,2}b"
+};
+
+const char *SUBJECTS[] = {
+    "", "xterm", "XTerm", "urxvt", "urxvt256", "st", "Firefox", "Navigator",
+    "Mozilla Firefox", "Welcome - Mozilla Firefox", "gimp-2.10", "Gimp.bin",
+    "Gimp-2.10", "Gimp2.8", "org.gnome.Nautilus", "orgXgnomeXNautilus",
+    "yes", "no", "0", "3", "12", "fbrun", "Dialog(1)", "C++ *scratch*",
+    "notes.txt - Vim", "paper.pdf", "New Tab - Chromium", "a b - Chromium",
+    "abc", "aXc", "a\xc3\xa9" "c", "foobaz", "barba", "ababc", "xyzzy", "x",
+    "Thunderbird", "Inbox - Mozilla Thunderbird", "Mail - Inbox", "Calendar",
+    "aa-a", "ABC", "Caf\xc3\xa9", "\xc3\xa9t\xc3\xa9", "xx", "42", "word",
+    "foo", "a", "aab", "b", "(", "mpv", "\xc3\xa9"
+};
+
+const size_t NUM_PATTERNS = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+const size_t NUM_SUBJECTS = sizeof(SUBJECTS) / sizeof(SUBJECTS[0]);
+
+double seconds(clock_t start) {
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+#ifdef USE_REGEXP
+
+// the way FbTk::RegExp matched before
+struct Posix {
+    explicit Posix(const std::string &str): ok(false) {
+        std::string full = "^" + str + "$";
+        ok = regcomp(&regex, full.c_str(), REG_NOSUB | REG_EXTENDED) == 0;
+    }
+    ~Posix() {
+        if (ok)
+            regfree(&regex);
+    }
+    bool match(const std::string &str) const {
+        return ok && regexec(&regex, str.c_str(), 0, 0, 0) == 0;
+    }
+    regex_t regex;
+    bool ok;
+};
+
+#endif // USE_REGEXP
+
+} // end of anonymous namespace
+
+int test_match() {
+
+    printf("testing FbTk::RegExp::match() against regexec()\n");
+
+    int failed = 0;
+
+#ifdef USE_REGEXP
+    std::vector<std::string> subjects(SUBJECTS, SUBJECTS + NUM_SUBJECTS);
+    // and some noise for the automaton
+    srand(7);
+    const char alphabet[] = "abcxyz-. 09AX";
+    for (int i = 0; i < 2000; ++i) {
+        std::string s;
+        for (int j = rand() % 8; j > 0; --j)
+            s += alphabet[rand() % (sizeof(alphabet) - 1)];
+        subjects.push_back(s);
+    }
+
+    for (size_t p = 0; p < NUM_PATTERNS; ++p) {
+        FbTk::RegExp regexp(PATTERNS[p]);
+        Posix posix(PATTERNS[p]);
+        if (regexp.error() != !posix.ok) {
+            printf("  \"%s\": error() is %d\n", PATTERNS[p], regexp.error());
+            ++failed;
+            continue;
+        }
+        for (size_t s = 0; s < subjects.size(); ++s) {
+            if (regexp.match(subjects[s]) != posix.match(subjects[s])) {
+                printf("  \"%s\" on \"%s\": %d\n", PATTERNS[p], subjects[s].c_str(),
+                       regexp.match(subjects[s]));
+                ++failed;
+            }
+        }
+    }
+#endif // USE_REGEXP
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_benchmark() {
+
+    printf("testing FbTk::RegExp::match() speed, %lu patterns on %lu strings\n",
+           (unsigned long)NUM_PATTERNS, (unsigned long)NUM_SUBJECTS);
+
+    int failed = 0;
+
+#ifdef USE_REGEXP
+    std::vector<FbTk::RegExp *> regexps;
+    std::vector<Posix *> posix;
+    for (size_t p = 0; p < NUM_PATTERNS; ++p) {
+        regexps.push_back(new FbTk::RegExp(PATTERNS[p]));
+        posix.push_back(new Posix(PATTERNS[p]));
+    }
+    std::vector<std::string> subjects(SUBJECTS, SUBJECTS + NUM_SUBJECTS);
+
+    const int ROUNDS = 200;
+    size_t posix_hits = 0, hits = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t p = 0; p < NUM_PATTERNS; ++p) {
+            for (size_t s = 0; s < subjects.size(); ++s)
+                posix_hits += posix[p]->match(subjects[s]) ? 1 : 0;
+        }
+    }
+    double posix_time = seconds(start);
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t p = 0; p < NUM_PATTERNS; ++p) {
+            for (size_t s = 0; s < subjects.size(); ++s)
+                hits += regexps[p]->match(subjects[s]) ? 1 : 0;
+        }
+    }
+    double time = seconds(start);
+
+    printf("  %lu matches: regexec %.3fs, RegExp %.3fs\n",
+           (unsigned long)(ROUNDS * NUM_PATTERNS * subjects.size()), posix_time, time);
+    if (hits != posix_hits)
+        ++failed;
+
+    for (size_t p = 0; p < NUM_PATTERNS; ++p) {
+        delete regexps[p];
+        delete posix[p];
+    }
+#endif // USE_REGEXP
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int main(int argc, char **argv) {
+
+    // like fluxbox, so multibyte characters count as one
+    setlocale(LC_ALL, "");
+
+    int failed = 0;
+    failed += test_match();
+    failed += test_benchmark();
+
+    return failed ? 1 : 0;
+}
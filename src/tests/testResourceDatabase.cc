@@ -0,0 +1,381 @@
+#include "FbTk/ResourceDatabase.hh"
+
+#include <X11/Xlib.h>
+#include <X11/Xresource.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using std::string;
+using std::vector;
+
+namespace {
+
+string classOf(const string &name) {
+    string result(name);
+    bool start = true;
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (start)
+            result[i] = toupper(result[i]);
+        start = result[i] == '.';
+    }
+    return result;
+}
+
+void writeFile(const string &filename, const string &text) {
+    std::ofstream file(filename.c_str());
+    file << text;
+}
+
+string quote(const string &str) {
+    string result;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '\n')
+            result += "\\n";
+        else if (str[i] == '\t')
+            result += "\\t";
+        else
+            result += str[i];
+    }
+    return result;
+}
+
+/// looks up every name in the file through Xrm and the ResourceDatabase
+int compare(const string &filename, const vector<string> &names, bool verbose = true) {
+    int failed = 0;
+
+    XrmDatabase xrm = XrmGetFileDatabase(filename.c_str());
+    std::shared_ptr<const FbTk::ResourceDatabase> db = FbTk::ResourceDatabase::open(filename);
+    if ((xrm == 0) != (db == 0)) {
+        printf("  %s: Xrm %s the file, ResourceDatabase %s\n", filename.c_str(),
+               xrm ? "reads" : "rejects", db ? "reads" : "rejects");
+        return 1;
+    }
+    if (xrm == 0)
+        return 0;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        const string classname = classOf(names[i]);
+        char *type;
+        XrmValue xrm_value;
+        bool xrm_found = XrmGetResource(xrm, names[i].c_str(), classname.c_str(),
+                                        &type, &xrm_value);
+        string value;
+        bool found = db->lookup(names[i], classname, value);
+
+        if (xrm_found != found || (found && value != xrm_value.addr)) {
+            if (verbose && failed < 10)
+                printf("  %s: Xrm \"%s\", ResourceDatabase \"%s\"\n", names[i].c_str(),
+                       xrm_found ? quote(xrm_value.addr).c_str() : "(none)",
+                       found ? quote(value).c_str() : "(none)");
+            ++failed;
+        }
+    }
+    XrmDestroyDatabase(xrm);
+    return failed;
+}
+
+// the pid keeps parallel test runs apart
+string tempFile(const char *name) {
+    char pid[32];
+    sprintf(pid, "%d", int(getpid()));
+    return string("/tmp/testResourceDatabase.") + pid + "." + name;
+}
+
+} // end of anonymous namespace
+
+int test_syntax() {
+
+    printf("testing ResourceDatabase syntax against Xrm\n");
+
+    const string included = tempFile("included");
+    writeFile(included,
+              "session.included: yes\n"
+              "session.screen0.toolbar.visible: from include\n");
+
+    const string main = tempFile("init");
+    writeFile(main,
+              "! a comment: with a colon\n"
+              "# another kind of comment\n"
+              "session.screen0.toolbar.visible:\tTrue\n"
+              "session.screen0.toolbar.widthPercent:  66\n"
+              "   session.screen0.slit.autoHide :   False   \n"
+              "session.screen0.workspaceNames:\tone,two,three,\n"
+              "session.menuFile:\t~/.fluxbox/menu\n"
+              "session.escaped: a\\nb\\\\c\\101\\x\\ d\n"
+              "session.continued: first \\\n"
+              "  second\n"
+              "session.leading: \\ \\ two spaces\n"
+              "session.empty:\n"
+              "session.twice: first\n"
+              "session.twice: second\n"
+              "no colon here\n"
+              "session..double: dots\n"
+              "session.trailing.: dot\n"
+              "session.screen0.titlebar.left:\tStick \n"
+              "#include \"" + included.substr(included.rfind('/') + 1) + "\"\n"
+              "session.last: no newline");
+
+    const char *names[] = {
+        "session.screen0.toolbar.visible", "session.screen0.toolbar.widthPercent",
+        "session.screen0.slit.autoHide", "session.screen0.workspaceNames",
+        "session.menuFile", "session.escaped", "session.continued",
+        "session.leading", "session.empty", "session.twice", "no",
+        "session.double", "session..double", "session.trailing",
+        "session.screen0.titlebar.left", "session.included", "session.last",
+        "session.missing", "session.screen1.toolbar.visible"
+    };
+
+    int failed = compare(main, vector<string>(names, names + sizeof(names) / sizeof(names[0])));
+
+    const string empty = tempFile("empty");
+    writeFile(empty, "! nothing but a comment\n");
+    failed += compare(empty, vector<string>(1, "session.menuFile"));
+    failed += compare(tempFile("missing"), vector<string>(1, "session.menuFile"));
+
+    // includes that go round in circles end where Xrm ends them
+    const string self = tempFile("self");
+    writeFile(self,
+              "session.before: yes\n"
+              "#include \"" + self.substr(self.rfind('/') + 1) + "\"\n"
+              "session.after: yes\n");
+    const char *self_names[] = { "session.before", "session.after" };
+    failed += compare(self, vector<string>(self_names, self_names + 2));
+
+    const string first = tempFile("first"), second = tempFile("second");
+    writeFile(first,
+              "session.value: first\n"
+              "#include \"" + second.substr(second.rfind('/') + 1) + "\"\n");
+    writeFile(second,
+              "#include \"" + first.substr(first.rfind('/') + 1) + "\"\n"
+              "session.value: second\n"
+              "session.other: second\n");
+    const char *cycle_names[] = { "session.value", "session.other" };
+    failed += compare(first, vector<string>(cycle_names, cycle_names + 2));
+
+    unlink(included.c_str());
+    unlink(main.c_str());
+    unlink(empty.c_str());
+    unlink(self.c_str());
+    unlink(first.c_str());
+    unlink(second.c_str());
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_precedence() {
+
+    printf("testing ResourceDatabase precedence against Xrm, random wildcard entries\n");
+
+    srand(3);
+    const char *levels[4][3] = {
+        { "session", "Session", "?" },
+        { "screen0", "Screen0", "?" },
+        { "toolbar", "Toolbar", "?" },
+        { "visible", "Visible", "?" }
+    };
+    const char *names[] = { "session", "screen0", "screen1", "toolbar", "slit", "visible", "alpha" };
+
+    const string filename = tempFile("random");
+    int failed = 0;
+    for (int round = 0; round < 200; ++round) {
+        // a dozen entries, each level spelled as name, class or '?' or left out
+        string text;
+        for (int e = 0; e < 12; ++e) {
+            string spec;
+            bool skipped = false;
+            for (int l = 0; l < 4; ++l) {
+                if (l < 3 && rand() % 4 == 0) {
+                    skipped = true;
+                    continue;
+                }
+                spec += skipped || rand() % 4 == 0 ? "*" : (l == 0 ? "" : ".");
+                spec += levels[l][rand() % 3];
+                skipped = false;
+            }
+            char value[32];
+            sprintf(value, ": %d\n", e);
+            text += spec + value;
+        }
+        writeFile(filename, text);
+
+        vector<string> queries;
+        for (int q = 0; q < 20; ++q) {
+            string name = "session";
+            for (int l = 1; l < 4; ++l)
+                name += string(".") + names[rand() % 7];
+            queries.push_back(name);
+        }
+        queries.push_back("session.screen0.toolbar.visible");
+
+        FbTk::ResourceDatabase::forget(filename);
+        int round_failed = compare(filename, queries, failed == 0);
+        if (round_failed && failed == 0)
+            printf("  in:\n%s", text.c_str());
+        failed += round_failed;
+    }
+    unlink(filename.c_str());
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_merge() {
+
+    printf("testing ResourceDatabase::merge() against XrmMergeDatabases()\n");
+
+    const string style = tempFile("style");
+    writeFile(style,
+              "*font: sans\n"
+              "window.title.focus: flat\n"
+              "window.*.color: red\n"
+              "menu.frame.font: serif\n");
+    const string overlay = tempFile("overlay");
+    writeFile(overlay,
+              "window.title.focus: raised\n"
+              "window.title.*.color: blue\n"
+              "menu*font: mono\n");
+
+    XrmDatabase xrm = XrmGetFileDatabase(style.c_str());
+    XrmMergeDatabases(XrmGetFileDatabase(overlay.c_str()), &xrm);
+
+    FbTk::ResourceDatabase db;
+    db.load(style);
+    db.merge(*FbTk::ResourceDatabase::open(overlay));
+
+    const char *names[] = {
+        "window.title.focus", "window.title.focus.color", "window.label.focus.color",
+        "menu.frame.font", "menu.title.font", "toolbar.clock.font"
+    };
+    vector<string> queries(names, names + sizeof(names) / sizeof(names[0]));
+    int failed = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        char *type;
+        XrmValue xrm_value;
+        bool xrm_found = XrmGetResource(xrm, queries[i].c_str(), classOf(queries[i]).c_str(),
+                                        &type, &xrm_value);
+        string value;
+        bool found = db.lookup(queries[i], classOf(queries[i]), value);
+        if (xrm_found != found || (found && value != xrm_value.addr)) {
+            printf("  %s: Xrm \"%s\", ResourceDatabase \"%s\"\n", queries[i].c_str(),
+                   xrm_found ? xrm_value.addr : "(none)", found ? value.c_str() : "(none)");
+            ++failed;
+        }
+    }
+    XrmDestroyDatabase(xrm);
+
+    unlink(style.c_str());
+    unlink(overlay.c_str());
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_speed() {
+
+    printf("testing ResourceDatabase speed, 300 resources in a 300 line init file\n");
+
+    string text;
+    vector<string> queries;
+    char line[128];
+    for (int i = 0; i < 300; ++i) {
+        sprintf(line, "session.screen%d.resource%d", i % 2, i);
+        queries.push_back(line);
+        if (i % 10 != 0) // some aren't in the file
+            text += string(line) + ":\tvalue\n";
+    }
+    text += "*resource10: loose\n";
+
+    const string filename = tempFile("speed");
+    writeFile(filename, text);
+
+    const int ROUNDS = 50;
+    size_t xrm_found = 0, found = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        XrmDatabase xrm = XrmGetFileDatabase(filename.c_str());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            char *type;
+            XrmValue value;
+            xrm_found += XrmGetResource(xrm, queries[i].c_str(), classOf(queries[i]).c_str(),
+                                        &type, &value) ? 1 : 0;
+        }
+        XrmDestroyDatabase(xrm);
+    }
+    double xrm_time = double(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        FbTk::ResourceDatabase::forget(filename);
+        std::shared_ptr<const FbTk::ResourceDatabase> db = FbTk::ResourceDatabase::open(filename);
+        string value;
+        for (size_t i = 0; i < queries.size(); ++i)
+            found += db->lookup(queries[i], classOf(queries[i]), value) ? 1 : 0;
+    }
+    double time = double(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("  %d loads: Xrm %.3fs, ResourceDatabase %.3fs\n", ROUNDS, xrm_time, time);
+
+    // how fluxbox uses it: one load, then every resource of every screen
+    vector<string> classes;
+    for (size_t i = 0; i < queries.size(); ++i)
+        classes.push_back(classOf(queries[i]));
+    XrmDatabase xrm = XrmGetFileDatabase(filename.c_str());
+    start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < queries.size(); ++i) {
+            char *type;
+            XrmValue value;
+            xrm_found += XrmGetResource(xrm, queries[i].c_str(), classes[i].c_str(),
+                                        &type, &value) ? 1 : 0;
+        }
+    }
+    xrm_time = double(clock() - start) / CLOCKS_PER_SEC;
+    XrmDestroyDatabase(xrm);
+
+    std::shared_ptr<const FbTk::ResourceDatabase> db = FbTk::ResourceDatabase::open(filename);
+    start = clock();
+    for (int r = 0; r < ROUNDS; ++r) {
+        string value;
+        for (size_t i = 0; i < queries.size(); ++i)
+            found += db->lookup(queries[i], classes[i], value) ? 1 : 0;
+    }
+    time = double(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("  %d lookups: Xrm %.3fs, ResourceDatabase %.3fs\n",
+           ROUNDS * static_cast<int>(queries.size()), xrm_time, time);
+    unlink(filename.c_str());
+
+    int failed = found != xrm_found;
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int main(int argc, char **argv) {
+
+    XrmInitialize();
+
+    int failed = 0;
+    failed += test_syntax();
+    failed += test_precedence();
+    failed += test_merge();
+    failed += test_speed();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+#include "SpatialIndex.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Rect {
+    int x, y, width, height;
+    bool alive;
+};
+
+bool touches(const Rect &r, int x, int y, int width, int height) {
+    return r.x <= x + width && x <= r.x + r.width &&
+           r.y <= y + height && y <= r.y + r.height;
+}
+
+int test_query() {
+
+    printf("testing SpatialIndex::query() against brute force\n");
+
+    std::vector<Rect> rects(300);
+    SpatialIndex<int> index(64);
+
+    srand(42);
+    int failed = 0;
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        Rect &r = rects[i];
+        r.x = rand() % 3000 - 500;
+        r.y = rand() % 2000 - 500;
+        r.width = rand() % 800;
+        r.height = rand() % 600;
+        r.alive = true;
+        index.insert(i, r.x, r.y, r.width, r.height, i);
+    }
+
+    for (int round = 0; round < 500; ++round) {
+
+        // shuffle things around a bit: move, resize and remove
+        int i = rand() % rects.size();
+        Rect &r = rects[i];
+        if (rand() % 5 == 0) {
+            r.alive = !r.alive;
+            if (r.alive)
+                index.insert(i, r.x, r.y, r.width, r.height, i);
+            else
+                index.remove(i);
+        } else if (r.alive) {
+            r.x += rand() % 200 - 100;
+            r.y += rand() % 200 - 100;
+            r.width = rand() % 800;
+            r.height = rand() % 600;
+            index.insert(i, r.x, r.y, r.width, r.height, i);
+        }
+
+        int qx = rand() % 3000 - 500, qy = rand() % 2000 - 500;
+        int qw = rand() % 400, qh = rand() % 400;
+        if (round % 50 == 0) { // a half plane
+            qw = 1 << 20;
+            qh = 1 << 20;
+        }
+
+        std::vector<int> expected, result;
+        for (size_t j = 0; j < rects.size(); ++j) {
+            if (rects[j].alive && touches(rects[j], qx, qy, qw, qh))
+                expected.push_back(j);
+        }
+        index.query(qx, qy, qw, qh, result);
+
+        if (result != expected) {
+            printf("  %d: query [%d %d %d %d]: got %u items, expected %u: failed\n",
+                   round, qx, qy, qw, qh,
+                   (unsigned int)result.size(), (unsigned int)expected.size());
+            ++failed;
+        }
+    }
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_order() {
+
+    printf("testing SpatialIndex result order\n");
+
+    SpatialIndex<int> index;
+    index.insert(1, 0, 0, 10, 10, 30);
+    index.insert(2, 5, 5, 10, 10, 10);
+    index.insert(3, 0, 0, 1000, 1000, 20);
+
+    std::vector<int> result;
+    index.query(0, 0, 20, 20, result);
+
+    bool ok = result.size() == 3 &&
+        result[0] == 2 && result[1] == 3 && result[2] == 1;
+    printf("  %s\n", ok ? "ok" : "failed");
+    printf("done.\n");
+
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = 0;
+    failed += test_query();
+    failed += test_order();
+
+    return failed ? 1 : 0;
+}
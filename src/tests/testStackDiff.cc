@@ -0,0 +1,126 @@
+#include "FbTk/StackDiff.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using FbTk::StackMove;
+
+namespace {
+
+// applies the moves like the server would
+void applyMoves(std::vector<int> &stack, const std::vector<StackMove<int> > &moves) {
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const StackMove<int> &m = moves[i];
+        stack.erase(std::remove(stack.begin(), stack.end(), m.window), stack.end());
+        std::vector<int>::iterator sib = std::find(stack.begin(), stack.end(), m.sibling);
+        if (!m.above)
+            ++sib;
+        stack.insert(sib, m.window);
+    }
+}
+
+// relative order of 'wanted' within 'stack'
+bool inOrder(const std::vector<int> &stack, const std::vector<int> &wanted) {
+    std::vector<int> filtered;
+    for (size_t i = 0; i < stack.size(); ++i) {
+        if (std::find(wanted.begin(), wanted.end(), stack[i]) != wanted.end())
+            filtered.push_back(stack[i]);
+    }
+    return filtered == wanted;
+}
+
+} // end of anonymous namespace
+
+int test_random() {
+
+    printf("testing FbTk::diffStack() on random orders\n");
+
+    srand(5);
+    int failed = 0;
+
+    for (int round = 0; round < 500; ++round) {
+        std::vector<int> from;
+        const int n = rand() % 40;
+        for (int i = 0; i < n; ++i)
+            from.push_back(i);
+
+        std::vector<int> to = from;
+        // a few raises, lowers, new and removed windows
+        for (int k = rand() % 5; k > 0 && !to.empty(); --k) {
+            int i = rand() % to.size(), j = rand() % to.size();
+            int w = to[i];
+            to.erase(to.begin() + i);
+            to.insert(to.begin() + j, w);
+        }
+        if (rand() % 3 == 0)
+            to.insert(to.begin() + rand() % (to.size() + 1), 1000 + round);
+        if (rand() % 3 == 0 && !to.empty())
+            to.erase(to.begin() + rand() % to.size());
+        if (round % 50 == 0) { // everything changes
+            for (size_t i = to.size(); i > 1; --i)
+                std::swap(to[i - 1], to[rand() % i]);
+        }
+
+        std::vector<StackMove<int> > moves;
+        FbTk::diffStack(from, to, moves);
+
+        // new windows start out on top of everything
+        std::vector<int> stack;
+        for (size_t i = 0; i < to.size(); ++i) {
+            if (std::find(from.begin(), from.end(), to[i]) == from.end())
+                stack.push_back(to[i]);
+        }
+        stack.insert(stack.end(), from.begin(), from.end());
+        applyMoves(stack, moves);
+        if (!inOrder(stack, to)) {
+            printf("  round %d: wrong order after %u moves: failed\n",
+                   round, (unsigned int)moves.size());
+            ++failed;
+        }
+    }
+
+    printf("  %s\n", failed ? "failed" : "ok");
+    printf("done.\n");
+
+    return failed;
+}
+
+int test_raise() {
+
+    printf("counting stacking requests per raise with 200 windows\n");
+
+    std::vector<int> from;
+    for (int i = 0; i < 200; ++i)
+        from.push_back(i);
+
+    size_t total = 0, worst = 0;
+    for (int i = 1; i < 200; ++i) {
+        std::vector<int> to = from;
+        to.erase(to.begin() + i);
+        to.insert(to.begin(), i);
+
+        std::vector<StackMove<int> > moves;
+        FbTk::diffStack(from, to, moves);
+        total += moves.size();
+        worst = std::max(worst, moves.size());
+    }
+
+    printf("  %.2f requests per raise on average, %u at most (full restack: 199)\n",
+           total / 199.0, (unsigned int)worst);
+    bool ok = (worst == 1);
+    printf("  %s\n", ok ? "ok" : "failed");
+    printf("done.\n");
+
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = 0;
+    failed += test_random();
+    failed += test_raise();
+
+    return failed ? 1 : 0;
+}